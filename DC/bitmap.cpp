@@ -0,0 +1,132 @@
+
+#include <core/bitmap.hpp>
+#include <cassert>
+
+namespace CoGaDB{
+
+	Bitmap::Bitmap(size_t number_of_rows, bool value) : words_((number_of_rows+63)/64, value ? ~uint64_t(0) : uint64_t(0)), number_of_rows_(number_of_rows){
+		clearUnusedBits();
+	}
+
+	size_t Bitmap::count() const{
+		size_t number_of_set_bits=0;
+		for(size_t i=0;i<words_.size();++i){
+			number_of_set_bits+=__builtin_popcountll(words_[i]);
+		}
+		return number_of_set_bits;
+	}
+
+	size_t Bitmap::count(TID begin, TID end) const{
+		if(begin>=end) return 0;
+		size_t first_word = begin/64;
+		size_t last_word = (end-1)/64;
+		uint64_t first_mask = ~uint64_t(0) << (begin%64);
+		uint64_t last_mask = ~uint64_t(0) >> (63-((end-1)%64));
+		if(first_word==last_word){
+			return __builtin_popcountll(words_[first_word] & first_mask & last_mask);
+		}
+		size_t number_of_set_bits = __builtin_popcountll(words_[first_word] & first_mask);
+		for(size_t i=first_word+1;i<last_word;++i){
+			number_of_set_bits+=__builtin_popcountll(words_[i]);
+		}
+		return number_of_set_bits + __builtin_popcountll(words_[last_word] & last_mask);
+	}
+
+	void Bitmap::setRange(TID begin, TID end){
+		if(begin>=end) return;
+		size_t first_word = begin/64;
+		size_t last_word = (end-1)/64;
+		uint64_t first_mask = ~uint64_t(0) << (begin%64);
+		uint64_t last_mask = ~uint64_t(0) >> (63-((end-1)%64));
+		if(first_word==last_word){
+			words_[first_word] |= first_mask & last_mask;
+			return;
+		}
+		words_[first_word] |= first_mask;
+		for(size_t i=first_word+1;i<last_word;++i){
+			words_[i] = ~uint64_t(0);
+		}
+		words_[last_word] |= last_mask;
+	}
+
+	Bitmap& Bitmap::operator&=(const Bitmap& bitmap){
+		assert(number_of_rows_==bitmap.number_of_rows_);
+		for(size_t i=0;i<words_.size();++i){
+			words_[i] &= bitmap.words_[i];
+		}
+		return *this;
+	}
+
+	Bitmap& Bitmap::operator|=(const Bitmap& bitmap){
+		assert(number_of_rows_==bitmap.number_of_rows_);
+		for(size_t i=0;i<words_.size();++i){
+			words_[i] |= bitmap.words_[i];
+		}
+		return *this;
+	}
+
+	Bitmap& Bitmap::flip(){
+		for(size_t i=0;i<words_.size();++i){
+			words_[i] = ~words_[i];
+		}
+		clearUnusedBits();
+		return *this;
+	}
+
+	bool Bitmap::operator==(const Bitmap& bitmap) const{
+		return number_of_rows_==bitmap.number_of_rows_ && words_==bitmap.words_;
+	}
+
+	const PositionListPtr Bitmap::toPositionList() const{
+		PositionListPtr tids( new PositionList());
+		tids->reserve(count());
+		for(size_t i=0;i<words_.size();++i){
+			uint64_t word = words_[i];
+			while(word){
+				tids->push_back(i*64+__builtin_ctzll(word));
+				//clear the lowest set bit
+				word &= word-1;
+			}
+		}
+		return tids;
+	}
+
+	const BitmapPtr Bitmap::fromPositionList(const PositionList& tids, size_t number_of_rows){
+		BitmapPtr bitmap( new Bitmap(number_of_rows));
+		for(size_t i=0;i<tids.size();++i){
+			bitmap->set(tids[i]);
+		}
+		return bitmap;
+	}
+
+	void Bitmap::clearUnusedBits(){
+		if(number_of_rows_%64!=0){
+			words_.back() &= ~uint64_t(0) >> (64-number_of_rows_%64);
+		}
+	}
+
+	SelectionResult::SelectionResult(PositionListPtr tids, size_t number_of_rows) : tids_(tids), bitmap_(), number_of_rows_(number_of_rows){
+
+	}
+
+	SelectionResult::SelectionResult(BitmapPtr bitmap) : tids_(), bitmap_(bitmap), number_of_rows_(bitmap->size()){
+
+	}
+
+	size_t SelectionResult::count() const{
+		if(bitmap_) return bitmap_->count();
+		return tids_->size();
+	}
+
+	const PositionListPtr SelectionResult::getPositionList() const{
+		if(bitmap_) return bitmap_->toPositionList();
+		return tids_;
+	}
+
+	const BitmapPtr SelectionResult::getBitmap() const{
+		if(bitmap_) return bitmap_;
+		return Bitmap::fromPositionList(*tids_,number_of_rows_);
+	}
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,58 @@
+
+#include <core/compact_position_list.hpp>
+#include <algorithm>
+
+namespace CoGaDB{
+
+	CompactPositionList::CompactPositionList(const PositionList& tids)
+		: representation_(RANGE), size_(tids.size()), first_(tids.empty() ? 0 : tids[0]), bases_(), offsets_(), tids_(){
+
+		bool dense=true;
+		bool sorted=true;
+		for(size_t i=1;i<tids.size();++i){
+			if(tids[i]!=first_+i) dense=false;
+			if(tids[i]<tids[i-1]){
+				sorted=false;
+				break;
+			}
+		}
+		if(dense && sorted) return;
+
+		if(sorted){
+			representation_=FRAME_OF_REFERENCE;
+			bases_.reserve((tids.size()+COMPACT_POSITION_LIST_BLOCK_SIZE-1)/COMPACT_POSITION_LIST_BLOCK_SIZE);
+			offsets_.resize(tids.size());
+			for(size_t begin=0;begin<tids.size() && representation_==FRAME_OF_REFERENCE;begin+=COMPACT_POSITION_LIST_BLOCK_SIZE){
+				size_t end = std::min(begin+COMPACT_POSITION_LIST_BLOCK_SIZE,tids.size());
+				//the TIDs are sorted, so the last TID of a block has the largest offset
+				if(tids[end-1]-tids[begin]>0xFFFF){
+					representation_=PLAIN;
+					break;
+				}
+				bases_.push_back(tids[begin]);
+				for(size_t i=begin;i<end;++i){
+					offsets_[i]=static_cast<uint16_t>(tids[i]-tids[begin]);
+				}
+			}
+			if(representation_==FRAME_OF_REFERENCE) return;
+			std::vector<TID>().swap(bases_);
+			std::vector<uint16_t>().swap(offsets_);
+		}
+		representation_=PLAIN;
+		tids_=tids;
+	}
+
+	const PositionListPtr CompactPositionList::toPositionList() const{
+		PositionListPtr tids (new PositionList(size_));
+		for(size_t i=0;i<size_;++i){
+			(*tids)[i]=(*this)[i];
+		}
+		return tids;
+	}
+
+	size_t CompactPositionList::getSizeinBytes() const throw(){
+		return sizeof(TID)*(bases_.capacity()+tids_.capacity())+sizeof(uint16_t)*offsets_.capacity();
+	}
+
+}; //end namespace CogaDB
+
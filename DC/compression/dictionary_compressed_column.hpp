@@ -6,6 +6,8 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <core/column.hpp>
+#include <core/parallel.hpp>
 using namespace std;
 
 namespace CoGaDB{
@@ -41,17 +43,81 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	virtual unsigned int getSizeinBytes() const throw();
 
 	virtual const ColumnPtr copy() const;
+	/*! \brief gathers the codes with prefetching and decodes them with the dictionary, which usually stays in the cache*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	virtual const ColumnPtr gather(BitmapPtr tids);
+	virtual void gatherValues(const TID* tids, size_t number_of_tids, T* result);
 
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 
-
+	/*! \brief sorts the column by a counting sort on the ranks of the dictionary codes*/
+	virtual const PositionListPtr sort(SortOrder order);
+	/*! \brief computes the top k on the ranks of the dictionary codes and stops scanning as soon as all k TIDs are found*/
+	virtual const PositionListPtr topk(unsigned int k, SortOrder order);
+	/*! \brief evaluates the predicate once per dictionary entry and filters the codes*/
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief returns true if the order of the codes equals the order of the values in the dictionary*/
+	bool isOrderPreserving() const;
+	virtual const std::vector<int>* getDictionaryCodes() const;
+	virtual const std::vector<T>* getDictionary() const;
 	
 	virtual T& operator[](const int index);
 	
 	/*! values*/
 	std::vector<int> dc_vector;
 	std::vector<T> dictionary;
+
+	protected:
+	/*! \brief applies the operation to the dictionary only, so it costs O(|dictionary|) instead of O(rows)*/
+	virtual bool applyConstantOperation(ColumnAlgebraOperation op, const T& value);
+	/*! \brief returns the dictionary entries that are used by at least one row*/
+	virtual void getDistinctValues(std::vector<T>& values);
+	/*! \brief aggregation operations count the occurrences of each code and aggregate each dictionary entry once, without decoding the column*/
+	virtual void aggregateAll(AggregationState<T>& state);
+	virtual void aggregatePositions(const PositionList& tids, AggregationState<T>& state);
+	virtual void aggregateBitmap(const Bitmap& tids, AggregationState<T>& state);
+
+	private:
+	/*! \brief adds each dictionary entry as often as its code occurs according to the code histogram*/
+	void aggregateCodeHistogram(const std::vector<size_t>& histogram, AggregationState<T>& state) const;
+	/*! \brief computes for each code the rank of its value w.r.t. order, equal values get the same rank
+	 *  \return the number of distinct ranks*/
+	unsigned int getCodeRanks(SortOrder order, std::vector<unsigned int>& rank) const;
+	/*! \brief evaluates the predicate once per dictionary entry
+	 *  \return the number of matching codes*/
+	unsigned int getMatchingCodes(const ValuePredicate<T>& predicate, std::vector<char>& code_matches) const;
+};
+
+/*! \brief ColumnFilter on dictionary codes, looks up one precomputed flag per code*/
+class DictionaryCodeFilter : public ColumnFilter{
+	public:
+	DictionaryCodeFilter(const std::vector<int>& codes, const std::vector<char>& code_matches) : codes_(codes), code_matches_(code_matches){}
+
+	virtual size_t filter(TID begin, TID end, TID* result){
+		size_t number_of_matches=0;
+		for(TID i=begin;i<end;i++){
+			result[number_of_matches]=i;
+			number_of_matches+=code_matches_[codes_[i]];
+		}
+		return number_of_matches;
+	}
+
+	virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result){
+		size_t number_of_matches=0;
+		for(size_t i=0;i<number_of_candidates;i++){
+			TID tid=candidates[i];
+			result[number_of_matches]=tid;
+			number_of_matches+=code_matches_[codes_[tid]];
+		}
+		return number_of_matches;
+	}
+
+	private:
+	const std::vector<int>& codes_;
+	std::vector<char> code_matches_;
 };
 
 
@@ -93,6 +159,8 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 			dictionary.push_back(new_value);
 			dc_vector.push_back(dictionary.size() - 1);
 		}	
+		this->statistics_.insert(new_value);
+		this->indexInsert(new_value);
 		return true;
 	}
 	
@@ -145,12 +213,64 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		return ColumnPtr(new DictionaryCompressedColumn<T>(*this));
 	}
 
+	template<class T>
+	void DictionaryCompressedColumn<T>::getDistinctValues(std::vector<T>& values){
+		std::vector<char> used_codes(dictionary.size(),0);
+		for(size_t i=0;i<dc_vector.size();i++){
+			used_codes[dc_vector[i]]=1;
+		}
+		for(size_t code=0;code<dictionary.size();code++){
+			if(used_codes[code]) values.push_back(dictionary[code]);
+		}
+	}
+
+	template<class T>
+	const ColumnPtr DictionaryCompressedColumn<T>::gather(PositionListPtr tids){
+		if(!tids || !is_valid_position_list(*tids,dc_vector.size())) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.resize(tids->size());
+		T* result_data = result_values.data();
+		const int* codes = dc_vector.data();
+		const T* values = dictionary.data();
+		const TID* positions = tids->data();
+		parallel_for_chunks(tids->size(),getNumberOfThreads(tids->size()),
+			[result_data,codes,values,positions](unsigned int, size_t begin, size_t end){
+				gather_dictionary_values(result_data+begin,codes,values,positions+begin,end-begin);
+			});
+		return result;
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::gatherValues(const TID* tids, size_t number_of_tids, T* result){
+		gather_dictionary_values(result,dc_vector.data(),dictionary.data(),tids,number_of_tids);
+	}
+
+	template<class T>
+	const ColumnPtr DictionaryCompressedColumn<T>::gather(BitmapPtr tids){
+		if(!tids || tids->size()!=dc_vector.size()) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.reserve(tids->count());
+		const std::vector<uint64_t>& words = tids->getWords();
+		for(size_t i=0;i<words.size();i++){
+			uint64_t word = words[i];
+			while(word){
+				result_values.push_back(dictionary[dc_vector[i*64+__builtin_ctzll(word)]]);
+				word &= word-1;
+			}
+		}
+		return result;
+	}
+
 	template<class T>
 	bool DictionaryCompressedColumn<T>::update(TID tid, const boost::any& new_value){
 		
 		if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
 			T value = boost::any_cast<T>(new_value);
+			this->statistics_.update(value,1,this->keepsOrder(tid,value));
+			this->indexUpdate(tid,dictionary[dc_vector[tid]],value);
 			unsigned pos;
 			pos = find(dictionary.begin(), dictionary.end(), value) - dictionary.begin();
 			if(pos < dictionary.size())
@@ -202,8 +322,9 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	
 	template<class T>
 	bool DictionaryCompressedColumn<T>::remove(TID tid){
+		this->indexRemove(tid,dictionary[dc_vector[tid]]);
 		dc_vector.erase(dc_vector.begin()+tid);
-	
+		this->statistics_.remove(1);
 		return true;	
 	}
 	
@@ -221,7 +342,8 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		//delete tuples in reverse order, otherwise the first deletion would invalidate all other tids
 		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit)
 			dc_vector.erase(dc_vector.begin()+(*rit));
-			
+		this->statistics_.remove(tids->size());
+		this->invalidateIndex();
 		return true;			
 	}
 
@@ -230,6 +352,8 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	
 		dc_vector.clear();
 		dictionary.clear();
+		this->statistics_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -279,9 +403,240 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		boost::archive::binary_iarchive ia2(infile2);
 		ia2 >> dictionary;
 		infile2.close();
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		return true;
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::isOrderPreserving() const{
+		for(unsigned int i=1;i<dictionary.size();i++){
+			if(!(dictionary[i-1]<dictionary[i])) return false;
+		}
 		return true;
 	}
 
+	template<class T>
+	unsigned int DictionaryCompressedColumn<T>::getCodeRanks(SortOrder order, std::vector<unsigned int>& rank) const{
+		const unsigned int dictionary_size = dictionary.size();
+		rank.resize(dictionary_size);
+		unsigned int number_of_ranks = dictionary_size;
+		if(isOrderPreserving()){
+			for(unsigned int i=0;i<dictionary_size;i++){
+				rank[i]=i;
+			}
+		}else{
+			std::vector<std::pair<T,TID> > sorted_dictionary(dictionary_size);
+			for(unsigned int i=0;i<dictionary_size;i++){
+				sorted_dictionary[i]=std::pair<T,TID>(dictionary[i],i);
+			}
+			typename ColumnBaseTyped<T>::ValueLesser lesser;
+			std::sort(sorted_dictionary.begin(),sorted_dictionary.end(),lesser);
+			unsigned int current_rank=0;
+			for(unsigned int i=0;i<dictionary_size;i++){
+				if(i>0 && lesser(sorted_dictionary[i-1],sorted_dictionary[i])) current_rank++;
+				rank[sorted_dictionary[i].second]=current_rank;
+			}
+			number_of_ranks=current_rank+1;
+		}
+		if(order==DESCENDING){
+			for(unsigned int i=0;i<dictionary_size;i++){
+				rank[i]=number_of_ranks-1-rank[i];
+			}
+		}
+		return number_of_ranks;
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::sort(SortOrder order){
+		if(order!=ASCENDING && order!=DESCENDING){
+			return ColumnBaseTyped<T>::sort(order);
+		}
+		PositionListPtr sorted_tids = this->getSortedTIDs(order);
+		if(sorted_tids) return sorted_tids;
+
+		std::vector<unsigned int> rank;
+		const unsigned int number_of_ranks = getCodeRanks(order,rank);
+
+		//stable counting sort of the rows by the rank of their code
+		std::vector<size_t> offsets(number_of_ranks+1,0);
+		for(unsigned int i=0;i<dc_vector.size();i++){
+			offsets[rank[dc_vector[i]]+1]++;
+		}
+		for(unsigned int i=1;i<offsets.size();i++){
+			offsets[i]+=offsets[i-1];
+		}
+		PositionListPtr ids = PositionListPtr( new PositionList(dc_vector.size()));
+		for(unsigned int i=0;i<dc_vector.size();i++){
+			(*ids)[offsets[rank[dc_vector[i]]]++]=i;
+		}
+		return ids;
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::topk(unsigned int k, SortOrder order){
+		if(k>=dc_vector.size() || (order!=ASCENDING && order!=DESCENDING)){
+			return ColumnBaseTyped<T>::topk(k,order);
+		}
+
+		std::vector<unsigned int> rank;
+		const unsigned int number_of_ranks = getCodeRanks(order,rank);
+
+		//find the rank of the k-th value, all rows with a smaller rank belong to the result
+		std::vector<size_t> histogram(number_of_ranks,0);
+		for(unsigned int i=0;i<dc_vector.size();i++){
+			histogram[rank[dc_vector[i]]]++;
+		}
+		unsigned int cutoff_rank=0;
+		size_t rows_before_cutoff=0;
+		while(rows_before_cutoff+histogram[cutoff_rank]<k){
+			rows_before_cutoff+=histogram[cutoff_rank];
+			cutoff_rank++;
+		}
+		//rows with the cutoff rank are taken in TID order until k rows are found
+		size_t remaining_before_cutoff = rows_before_cutoff;
+		size_t remaining_on_cutoff = k-rows_before_cutoff;
+
+		//offsets of each rank in the result, computed as in a counting sort
+		std::vector<size_t> offsets(cutoff_rank+1,0);
+		for(unsigned int r=1;r<=cutoff_rank;r++){
+			offsets[r]=offsets[r-1]+histogram[r-1];
+		}
+		PositionListPtr ids = PositionListPtr( new PositionList(k));
+		for(unsigned int i=0;i<dc_vector.size() && (remaining_before_cutoff>0 || remaining_on_cutoff>0);i++){
+			unsigned int r = rank[dc_vector[i]];
+			if(r<cutoff_rank){
+				(*ids)[offsets[r]++]=i;
+				remaining_before_cutoff--;
+			}else if(r==cutoff_rank && remaining_on_cutoff>0){
+				(*ids)[offsets[r]++]=i;
+				remaining_on_cutoff--;
+			}
+		}
+		return ids;
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return this->parallel_selection(value_for_comparison,comp,getNumberOfThreads(dc_vector.size()));
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		//a sorted column is searched instead of scanned
+		TID range_begin, range_end;
+		if(this->findSortedRange(predicate,range_begin,range_end)){
+			PositionListPtr result_tids( new PositionList(range_end-range_begin));
+			for(TID i=range_begin;i<range_end;++i){
+				(*result_tids)[i-range_begin]=i;
+			}
+			return result_tids;
+		}
+		PositionListPtr index_tids = this->indexSelection(predicate);
+		if(index_tids) return index_tids;
+		//evaluate the predicate on the dictionary, so the scan only looks up one flag per code
+		std::vector<char> code_matches;
+		if(getMatchingCodes(predicate,code_matches)==0){
+			return PositionListPtr( new PositionList());
+		}
+
+		const int* codes = dc_vector.data();
+		const char* matches = code_matches.data();
+		return parallel_scan(dc_vector.size(),number_of_threads,
+			[codes,matches](size_t begin, size_t end, PositionList& result){
+				for(size_t i=begin;i<end;++i){
+					if(matches[codes[i]]) result.push_back(i);
+				}
+			});
+	}
+
+	template<class T>
+	unsigned int DictionaryCompressedColumn<T>::getMatchingCodes(const ValuePredicate<T>& predicate, std::vector<char>& code_matches) const{
+		code_matches.resize(dictionary.size());
+		unsigned int number_of_matching_codes=0;
+		for(unsigned int i=0;i<dictionary.size();i++){
+			code_matches[i]=predicate(dictionary[i]);
+			number_of_matching_codes+=code_matches[i];
+		}
+		return number_of_matching_codes;
+	}
+
+	template<class T>
+	const ColumnFilterPtr DictionaryCompressedColumn<T>::createFilter(const boost::any& value_for_comparison, const ValueComparator comp){
+		std::vector<char> code_matches;
+		getMatchingCodes(this->getPredicate(value_for_comparison,comp),code_matches);
+		return ColumnFilterPtr(new DictionaryCodeFilter(dc_vector,code_matches));
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::applyConstantOperation(ColumnAlgebraOperation op, const T& value){
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		return apply_constant_operation(dictionary.data(),dictionary.size(),op,value);
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::aggregateAll(AggregationState<T>& state){
+		const int* codes = dc_vector.data();
+		const size_t dictionary_size = dictionary.size();
+		//a thread does not necessarily process a morsel, so all histograms are sized before the merge reads them
+		std::vector<std::vector<size_t> > histograms(getNumberOfThreads(dc_vector.size()),std::vector<size_t>(dictionary_size,0));
+		parallel_for_chunks(dc_vector.size(),histograms.size(),
+			[codes,&histograms](unsigned int thread_id, size_t begin, size_t end){
+				std::vector<size_t>& histogram = histograms[thread_id];
+				for(size_t i=begin;i<end;++i){
+					histogram[codes[i]]++;
+				}
+			});
+		for(size_t i=1;i<histograms.size();i++){
+			for(size_t code=0;code<histograms[i].size();code++){
+				histograms[0][code]+=histograms[i][code];
+			}
+		}
+		aggregateCodeHistogram(histograms[0],state);
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::aggregatePositions(const PositionList& tids, AggregationState<T>& state){
+		std::vector<size_t> histogram(dictionary.size(),0);
+		for(size_t i=0;i<tids.size();i++){
+			histogram[dc_vector[tids[i]]]++;
+		}
+		aggregateCodeHistogram(histogram,state);
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::aggregateBitmap(const Bitmap& tids, AggregationState<T>& state){
+		std::vector<size_t> histogram(dictionary.size(),0);
+		const std::vector<uint64_t>& words = tids.getWords();
+		for(size_t i=0;i<words.size();i++){
+			uint64_t word = words[i];
+			while(word){
+				histogram[dc_vector[i*64+__builtin_ctzll(word)]]++;
+				word &= word-1;
+			}
+		}
+		aggregateCodeHistogram(histogram,state);
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::aggregateCodeHistogram(const std::vector<size_t>& histogram, AggregationState<T>& state) const{
+		for(size_t code=0;code<histogram.size();code++){
+			state.add(dictionary[code],histogram[code]);
+		}
+	}
+
+	template<class T>
+	const std::vector<int>* DictionaryCompressedColumn<T>::getDictionaryCodes() const{
+		return &dc_vector;
+	}
+
+	template<class T>
+	const std::vector<T>* DictionaryCompressedColumn<T>::getDictionary() const{
+		return &dictionary;
+	}
+
 	template<class T>
 	T& DictionaryCompressedColumn<T>::operator[](const int index){
 		return dictionary[dc_vector[index]];
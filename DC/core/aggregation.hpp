@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <stdint.h>
+#include <boost/any.hpp>
+#include <core/global_definitions.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     AggregationTraits defines the type in which values of type T are summed up.
+ *  \details   INT columns are summed up in 64 bit integers and FLOAT columns in doubles, so that large columns do not overflow or lose precision.
+ *             Strings do not support SUM and AVG.
+ */
+template<class T>
+struct AggregationTraits{
+	typedef T SumType;
+	static const bool supports_sum = true;
+	static inline SumType zero(){ return SumType(0); }
+	static inline void addToSum(SumType& sum, const T& value, size_t count){ sum+=SumType(value)*SumType(count); }
+	static inline double average(const SumType& sum, size_t count){ return double(sum)/count; }
+};
+
+template<>
+struct AggregationTraits<int>{
+	typedef int64_t SumType;
+	static const bool supports_sum = true;
+	static inline SumType zero(){ return 0; }
+	static inline void addToSum(SumType& sum, const int& value, size_t count){ sum+=SumType(value)*SumType(count); }
+	static inline double average(const SumType& sum, size_t count){ return double(sum)/count; }
+};
+
+template<>
+struct AggregationTraits<float>{
+	typedef double SumType;
+	static const bool supports_sum = true;
+	static inline SumType zero(){ return 0; }
+	static inline void addToSum(SumType& sum, const float& value, size_t count){ sum+=SumType(value)*SumType(count); }
+	static inline double average(const SumType& sum, size_t count){ return sum/count; }
+};
+
+template<>
+struct AggregationTraits<std::string>{
+	typedef std::string SumType;
+	static const bool supports_sum = false;
+	static inline SumType zero(){ return SumType(); }
+	static inline void addToSum(SumType&, const std::string&, size_t){}
+	static inline double average(const SumType&, size_t){ return 0; }
+};
+
+/*!
+ *  \brief     An AggregationState summarizes a multiset of values by their count, sum, minimum and maximum, from which all AggregationMethods are computed.
+ *  \details   States of disjoint parts of a column, e.g., of threads, runs or blocks, are combined with merge.
+ */
+template<class T>
+class AggregationState{
+	public:
+	typedef typename AggregationTraits<T>::SumType SumType;
+
+	AggregationState() : count_(0), sum_(AggregationTraits<T>::zero()), min_(), max_(){}
+
+	/*! \brief adds a value count times*/
+	inline void add(const T& value, size_t count=1){
+		if(count==0) return;
+		if(count_==0){
+			min_=value;
+			max_=value;
+		}else{
+			//a NaN does not bound the values, unless all values are NaN
+			if(value<min_ || is_unordered(min_,min_)) min_=value;
+			if(max_<value || is_unordered(max_,max_)) max_=value;
+		}
+		AggregationTraits<T>::addToSum(sum_,value,count);
+		count_+=count;
+	}
+
+	/*! \brief adds count values with the given sum, minimum and maximum*/
+	inline void add(size_t count, const SumType& sum, const T& min, const T& max){
+		if(count==0) return;
+		if(count_==0 || min<min_ || is_unordered(min_,min_)) min_=min;
+		if(count_==0 || max_<max || is_unordered(max_,max_)) max_=max;
+		if(AggregationTraits<T>::supports_sum) sum_+=sum;
+		count_+=count;
+	}
+
+	inline void merge(const AggregationState<T>& state){
+		add(state.count_,state.sum_,state.min_,state.max_);
+	}
+
+	size_t getCount() const throw(){ return count_; }
+
+	/*! \brief returns the aggregate
+	 *  \details SUM returns an AggregationTraits<T>::SumType, MIN and MAX a T, COUNT a size_t and AVG a double. 
+	 *  The result is empty if the aggregate is not defined, i.e., MIN, MAX and AVG of no values and SUM and AVG of strings.*/
+	const boost::any getResult(AggregationMethod method) const{
+		switch(method){
+			case COUNT: return boost::any(count_);
+			case SUM: if(AggregationTraits<T>::supports_sum) return boost::any(sum_); break;
+			case MIN: if(count_>0) return boost::any(min_); break;
+			case MAX: if(count_>0) return boost::any(max_); break;
+			case AVG: if(AggregationTraits<T>::supports_sum && count_>0) return boost::any(AggregationTraits<T>::average(sum_,count_)); break;
+		}
+		return boost::any();
+	}
+
+	private:
+	size_t count_;
+	SumType sum_;
+	T min_;
+	T max_;
+};
+
+/*! \brief aggregates an array of values one by one*/
+template<class T>
+void aggregate_values(const T* values, size_t number_of_values, AggregationState<T>& state){
+	for(size_t i=0;i<number_of_values;++i){
+		state.add(values[i]);
+	}
+}
+
+/*! \brief aggregates an array of numeric values with vector instructions
+ *  \details each lane keeps its own sum, minimum and maximum, the lanes are combined at the end. Sums are computed in the wider SumType lanes.*/
+template<class T>
+void simd_aggregate_values(const T* values, size_t number_of_values, AggregationState<T>& state){
+	typedef typename AggregationTraits<T>::SumType SumType;
+	const size_t LANES = 8;
+	typedef T Vector __attribute__((vector_size(LANES*sizeof(T))));
+	typedef SumType SumVector __attribute__((vector_size(LANES*sizeof(SumType))));
+
+	size_t i=0;
+	if(number_of_values>=LANES){
+		Vector min, max;
+		std::memcpy(&min,values,sizeof(Vector));
+		max=min;
+		SumVector sum = {};
+		for(;i+LANES<=number_of_values;i+=LANES){
+			Vector v;
+			std::memcpy(&v,values+i,sizeof(Vector));
+			sum += __builtin_convertvector(v,SumVector);
+			//a lane that holds a NaN takes the next value, like AggregationState::add
+			min = ((v<min) | (min!=min)) ? v : min;
+			max = ((v>max) | (max!=max)) ? v : max;
+		}
+		SumType total_sum = AggregationTraits<T>::zero();
+		T total_min = min[0], total_max = max[0];
+		for(size_t lane=0;lane<LANES;++lane){
+			total_sum += sum[lane];
+			if(min[lane]<total_min || is_unordered(total_min,total_min)) total_min=min[lane];
+			if(total_max<max[lane] || is_unordered(total_max,total_max)) total_max=max[lane];
+		}
+		state.add(i,total_sum,total_min,total_max);
+	}
+	for(;i<number_of_values;++i){
+		state.add(values[i]);
+	}
+}
+
+inline void aggregate_values(const int* values, size_t number_of_values, AggregationState<int>& state){
+	simd_aggregate_values(values,number_of_values,state);
+}
+
+inline void aggregate_values(const float* values, size_t number_of_values, AggregationState<float>& state){
+	simd_aggregate_values(values,number_of_values,state);
+}
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <core/global_definitions.hpp>
+#include <core/hash_function.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of bits a BloomFilter reserves per key*/
+const unsigned int BLOOM_FILTER_BITS_PER_KEY = 16;
+/*! \brief number of bits a BloomFilter sets per key, all of them lie in the same 64 bit word*/
+const unsigned int BLOOM_FILTER_BITS_PER_BLOCK = 4;
+
+/*!
+ *  \brief     A BloomFilter is a compact, approximate set of keys: contains() never misses an inserted key, but may report keys that were
+ *             not inserted (false positives).
+ *  \details   The filter is register blocked: all bits of a key lie in a single 64 bit word, so a lookup loads one word and
+ *             compares it with a mask without branches, instead of touching BLOOM_FILTER_BITS_PER_BLOCK cache lines.
+ *             Besides the bits, the filter keeps the smallest and largest key, so compressed columns can skip runs and blocks whose
+ *             values lie outside of this range.
+ *             A BloomFilter built from the build side of a join can be passed as comparison value with the ValueComparator BLOOM_FILTER
+ *             to the selections and scans of the probe side, which removes most rows without a join partner before the join.
+ */
+template<class T>
+class BloomFilter{
+	public:
+	/*! \brief creates an empty filter for about number_of_keys keys*/
+	explicit BloomFilter(size_t number_of_keys);
+
+	void insert(const T& key);
+	/*! \brief returns false if key was not inserted, and true if it was inserted or in case of a false positive*/
+	inline bool contains(const T& key) const{
+		const uint64_t hash = getHash(key);
+		const uint64_t mask = getMask(hash);
+		return (words_[getWord(hash)] & mask)==mask;
+	}
+	/*! \brief returns true if at least one inserted key lies in [min,max]*/
+	bool mayContainRange(const T& min, const T& max) const{
+		return !empty_ && !(max<min_) && !(max_<min);
+	}
+	/*! \brief returns the number of bits of the filter*/
+	size_t getNumberOfBits() const throw(){ return words_.size()*64; }
+
+	private:
+	static inline uint64_t getHash(const T& key){
+		return compute_hash(key);
+	}
+	/*! \brief the upper 32 bits of the hash select the word*/
+	inline size_t getWord(uint64_t hash) const{
+		return (hash >> 32) & word_mask_;
+	}
+	/*! \brief each 6 bits of the lower 32 bits of the hash select one bit of the word*/
+	static inline uint64_t getMask(uint64_t hash){
+		uint64_t mask=0;
+		for(unsigned int i=0;i<BLOOM_FILTER_BITS_PER_BLOCK;++i){
+			mask |= uint64_t(1) << ((hash >> (6*i)) & 63);
+		}
+		return mask;
+	}
+
+	std::vector<uint64_t> words_;
+	/*! \brief number of words minus one, the number of words is a power of two*/
+	size_t word_mask_;
+	bool empty_;
+	T min_;
+	T max_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	BloomFilter<T>::BloomFilter(size_t number_of_keys) : words_(), word_mask_(0), empty_(true), min_(), max_(){
+		size_t number_of_words=1;
+		while(number_of_words*64<number_of_keys*BLOOM_FILTER_BITS_PER_KEY && number_of_words<(size_t(1)<<32)){
+			number_of_words*=2;
+		}
+		words_.resize(number_of_words,0);
+		word_mask_=number_of_words-1;
+	}
+
+	template<class T>
+	void BloomFilter<T>::insert(const T& key){
+		//a NaN equals no key, so it never has a join partner and must not widen the range
+		if(is_unordered(key,key)) return;
+		const uint64_t hash = getHash(key);
+		words_[getWord(hash)] |= getMask(hash);
+		if(empty_ || key<min_) min_=key;
+		if(empty_ || max_<key) max_=key;
+		empty_=false;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
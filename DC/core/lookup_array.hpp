@@ -3,6 +3,7 @@
 
 #include <core/column_base_typed.hpp>
 #include <core/column.hpp>
+#include <core/compact_position_list.hpp>
 #include <lookup_table/lookup_column.hpp>
 #include <core/base_table.hpp>
 
@@ -24,7 +25,11 @@ template<class T>
 class LookupArray : public ColumnBaseTyped<T>{
 	public:
 	/***************** constructors and destructor *****************/
+	/*! \brief if column is a LookupArray itself, the TIDs are translated into TIDs of the column it indexes, 
+	 *  so an access never goes through more than one LookupArray*/
 	LookupArray(const std::string& name, AttributeType db_type, ColumnPtr column, PositionListPtr tids);
+	/*! \brief creates a LookupArray that shares the TIDs with other LookupArrays*/
+	LookupArray(const std::string& name, AttributeType db_type, ColumnPtr column, CompactPositionListPtr tids);
 	virtual ~LookupArray();
 
 	virtual bool insert(const boost::any& new_Value);
@@ -44,6 +49,9 @@ class LookupArray : public ColumnBaseTyped<T>{
 	virtual unsigned int getSizeinBytes() const throw();
 
 	virtual const ColumnPtr copy() const;
+	/*! \brief translates the positions into TIDs of the indexed column and gathers all values from it in one call*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	virtual const ColumnPtr gather(BitmapPtr tids);
 
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
@@ -52,8 +60,16 @@ class LookupArray : public ColumnBaseTyped<T>{
 	/*! \brief returns type information of internal values*/
 	virtual T& operator[](const int index);
 	private:
+	/*! \brief returns the column indexed by column, if it is a LookupArray, and column otherwise*/
+	static const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > getIndexedColumn(ColumnPtr column);
+	/*! \brief returns the TIDs of the column returned by getIndexedColumn for the positions in tids*/
+	static const CompactPositionListPtr translateTIDs(ColumnPtr column, PositionListPtr tids);
+	static const CompactPositionListPtr translateTIDs(ColumnPtr column, CompactPositionListPtr tids);
+	template<typename PositionListType>
+	static const CompactPositionListPtr translatePositions(const LookupArray<T>& lookup_array, const PositionListType& tids);
+
 	shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > column_;
-	PositionListPtr tids_;
+	CompactPositionListPtr tids_;
 };
 
 	//typedef shared_pointer_namespace::shared_ptr<LookupArray> LookupArrayPtr;
@@ -64,8 +80,20 @@ class LookupArray : public ColumnBaseTyped<T>{
 	template<class T>
 	LookupArray<T>::LookupArray(const std::string& name, AttributeType db_type, ColumnPtr column, PositionListPtr tids) 
 						: ColumnBaseTyped<T>(name, db_type),
-						  column_( shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> > (column) ),
-						  tids_(tids) {
+						  column_( getIndexedColumn(column) ),
+						  tids_( translateTIDs(column, tids) ) {
+	
+		assert(column_!=NULL);
+		assert(tids_!=NULL);
+		assert(db_type==column->getType());
+
+	}
+
+	template<class T>
+	LookupArray<T>::LookupArray(const std::string& name, AttributeType db_type, ColumnPtr column, CompactPositionListPtr tids) 
+						: ColumnBaseTyped<T>(name, db_type),
+						  column_( getIndexedColumn(column) ),
+						  tids_( translateTIDs(column, tids) ) {
 	
 		assert(column_!=NULL);
 		assert(tids_!=NULL);
@@ -73,6 +101,39 @@ class LookupArray : public ColumnBaseTyped<T>{
 
 	}
 
+	template<class T>
+	const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > LookupArray<T>::getIndexedColumn(ColumnPtr column){
+		LookupArray<T>* lookup_array = dynamic_cast<LookupArray<T>*>(column.get());
+		if(lookup_array) return lookup_array->column_;
+		return shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> > (column);
+	}
+
+	template<class T>
+	const CompactPositionListPtr LookupArray<T>::translateTIDs(ColumnPtr column, PositionListPtr tids){
+		assert(tids!=NULL);
+		LookupArray<T>* lookup_array = dynamic_cast<LookupArray<T>*>(column.get());
+		if(!lookup_array) return CompactPositionListPtr(new CompactPositionList(*tids));
+		return translatePositions(*lookup_array,*tids);
+	}
+
+	template<class T>
+	const CompactPositionListPtr LookupArray<T>::translateTIDs(ColumnPtr column, CompactPositionListPtr tids){
+		assert(tids!=NULL);
+		LookupArray<T>* lookup_array = dynamic_cast<LookupArray<T>*>(column.get());
+		if(!lookup_array) return tids;
+		return translatePositions(*lookup_array,*tids);
+	}
+
+	template<class T>
+	template<typename PositionListType>
+	const CompactPositionListPtr LookupArray<T>::translatePositions(const LookupArray<T>& lookup_array, const PositionListType& tids){
+		PositionList translated_tids(tids.size());
+		for(unsigned int i=0;i<tids.size();i++){
+			translated_tids[i]=(*lookup_array.tids_)[tids[i]];
+		}
+		return CompactPositionListPtr(new CompactPositionList(translated_tids));
+	}
+
 	template<class T>
 	LookupArray<T>::~LookupArray(){
 
@@ -122,7 +183,7 @@ class LookupArray : public ColumnBaseTyped<T>{
 	void LookupArray<T>::print() const throw(){
 		
 		const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > column = column_;
-		const PositionListPtr tids = tids_;
+		const CompactPositionListPtr tids = tids_;
 
 		std::cout << "Lookup Array for Column " << column_->getName() << " ";
 		if(column_->isMaterialized()){
@@ -144,8 +205,24 @@ class LookupArray : public ColumnBaseTyped<T>{
 	}
 	template<class T>
 	const ColumnPtr LookupArray<T>::copy() const{
-		PositionListPtr new_tids (new PositionList(*tids_));
-		return ColumnPtr(new LookupArray<T>(this->name_,this->db_type_,this->column_,new_tids));
+		//the TIDs cannot be modified, so the copy shares them
+		return ColumnPtr(new LookupArray<T>(this->name_,this->db_type_,this->column_,this->tids_));
+	}
+
+	template<class T>
+	const ColumnPtr LookupArray<T>::gather(PositionListPtr tids){
+		if(!tids || !is_valid_position_list(*tids,tids_->size())) return ColumnPtr();
+		PositionListPtr translated_tids (new PositionList(tids->size()));
+		for(unsigned int i=0;i<tids->size();i++){
+			(*translated_tids)[i]=(*tids_)[(*tids)[i]];
+		}
+		return column_->gather(translated_tids);
+	}
+
+	template<class T>
+	const ColumnPtr LookupArray<T>::gather(BitmapPtr tids){
+		if(!tids || tids->size()!=tids_->size()) return ColumnPtr();
+		return this->gather(tids->toPositionList());
 	}
 	/***************** relational operations on LookupArrays which return lookup tables *****************/
 //	template<class T>
@@ -190,7 +267,7 @@ class LookupArray : public ColumnBaseTyped<T>{
 
 	template<class T>
 	unsigned int LookupArray<T>::getSizeinBytes() const throw(){
-		return tids_->capacity()*sizeof(typename PositionList::value_type);
+		return tids_->getSizeinBytes();
 	}
 
 /***************** End of Implementation Section ******************/
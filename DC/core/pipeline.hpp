@@ -0,0 +1,60 @@
+#pragma once
+
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of rows of the driving table a Pipeline pushes through its operators per batch*/
+const size_t PIPELINE_BATCH_SIZE = 4096;
+
+class PipelineOperator; //forward declaration, defined in pipeline.cpp
+/*! \brief a PipelineOperatorPtr is a references counted smart pointer to a PipelineOperator object*/
+typedef shared_pointer_namespace::shared_ptr<PipelineOperator> PipelineOperatorPtr;
+
+/*!
+ *  \brief     A Pipeline executes a query plan of selections, joins and aggregations by pushing batches of rows through all operators,
+ *             instead of materializing the result of each operator as a PositionList.
+ *  \details   The pipeline scans the rows of the driving table (table 0) in batches of PIPELINE_BATCH_SIZE rows. A batch holds one array of
+ *             TIDs per table, which are joined so far. Selections filter the batch with a ColumnFilter and joins probe a ColumnProbe on their
+ *             build column, which adds the build column as the next table. The operators are applied in the order they were added.
+ *             The result rows are passed to the aggregations, or collected as one PositionList per table if there is no aggregation.
+ *             The hash tables of the joins are built when the joins are added, so the columns must not be modified until the pipeline is executed.
+ */
+class Pipeline{
+	public:
+	/*! \brief creates a pipeline that scans the number_of_rows rows of the driving table*/
+	explicit Pipeline(size_t number_of_rows);
+	/*! \brief adds the filter condition (value_for_comparison, comp) on column, which belongs to table
+	 *  \return true for sucess and false in case the table does not exist or the column does not have as many rows as the table*/
+	bool addSelection(unsigned int table, ColumnPtr column, const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief adds an equi-join of probe_column, which belongs to table, with build_column, which becomes table getNumberOfTables()-1
+	 *  \return true for sucess and false in case the table does not exist, probe_column does not have as many rows as the table or the columns have different types*/
+	bool addJoin(unsigned int table, ColumnPtr probe_column, ColumnPtr build_column);
+	/*! \brief adds an aggregate of the values of column, which belongs to table, over all result rows
+	 *  \return true for sucess and false in case the table does not exist or the column does not have as many rows as the table*/
+	bool addAggregation(unsigned int table, ColumnPtr column, AggregationMethod method);
+	/*! \brief pushes all rows of the driving table through the operators
+	 *  \details the aggregates and the result TIDs of the previous execution are discarded*/
+	void execute();
+	/*! \brief returns the TIDs of table for each result row of the last execution
+	 *  \return PositionListPtr to a PositionList, a NULL pointer if the table does not exist or the pipeline has aggregations*/
+	const PositionListPtr getResult(unsigned int table) const;
+	/*! \brief returns the aggregate of the aggregation with number aggregation in the order they were added, as returned by ColumnBase::aggregate*/
+	const boost::any getAggregate(unsigned int aggregation) const;
+	unsigned int getNumberOfTables() const throw();
+	/*! \brief returns the Operation of each operator in the order in which they process a batch, starting with the FULL_SCAN of the driving table*/
+	const std::vector<Operation> getOperations() const;
+
+	private:
+	/*! \brief returns true if table exists and column has as many rows as the table*/
+	bool belongsToTable(unsigned int table, ColumnPtr column) const;
+
+	std::vector<PipelineOperatorPtr> operators_;
+	std::vector<PipelineOperatorPtr> aggregations_;
+	/*! \brief number of rows of each table*/
+	std::vector<size_t> table_sizes_;
+	std::vector<PositionListPtr> results_;
+};
+
+}; //end namespace CogaDB
+
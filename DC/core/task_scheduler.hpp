@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace CoGaDB{
+
+/*! \brief number of rows of a morsel, the unit of work the TaskScheduler assigns to its workers*/
+const size_t MORSEL_SIZE = 16*1024;
+
+/*!
+ *  \brief     The TaskScheduler is the process-wide pool of worker threads, one per available core and pinned to it, which processes
+ *             the morsels of all parallel operators.
+ *  \details   A job splits a range of rows into morsels. The morsels are distributed in contiguous ranges over the deques of the workers,
+ *             so each worker scans its part of the input in order. A worker takes one morsel at a time from the front of its deque and
+ *             moves the rest of the range to the back, so the jobs of concurrent queries alternate on each core. A worker with an empty deque
+ *             steals the upper half of a range from the back of another deque, which rebalances slow or skewed ranges.
+ *             The thread that submits a job takes part in it until all morsels are processed, so a morsel may submit a job itself.
+ */
+class TaskScheduler{
+	public:
+	/*! \brief processes the rows [begin,end) of a morsel, the first parameter is the participant that processes the morsel*/
+	typedef std::function<void(unsigned int,size_t,size_t)> MorselFunction;
+
+	/*! \brief returns the scheduler of the process, the workers are started by the first call*/
+	static TaskScheduler& getInstance();
+	~TaskScheduler();
+
+	/*! \brief calls function(participant,begin,end) for each morsel of morsel_size rows of [0,number_of_rows) and returns after all morsels are processed
+	 *  \details at most maximal_participants threads process the morsels of the job, the calling thread is participant 0.
+	 *  Each thread keeps its participant number in [0,maximal_participants) for the whole job, so function may keep per-participant state.*/
+	void execute(size_t number_of_rows, size_t morsel_size, unsigned int maximal_participants, const MorselFunction& function);
+	unsigned int getNumberOfWorkers() const throw();
+
+	private:
+	struct Job;
+	/*! \brief the morsels [first_morsel,last_morsel) of a job*/
+	struct Task{
+		Job* job;
+		size_t first_morsel;
+		size_t last_morsel;
+	};
+	struct WorkerQueue{
+		WorkerQueue() : mutex(), tasks(){}
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	TaskScheduler();
+	TaskScheduler(const TaskScheduler&);
+	TaskScheduler& operator=(const TaskScheduler&);
+
+	/*! \brief main loop of a worker, which processes morsels until the scheduler is destroyed*/
+	void work(unsigned int worker);
+	/*! \brief returns the participant number of worker in job, or -1 if the job already has all participants it may have*/
+	int getParticipant(Job& job, unsigned int worker);
+	/*! \brief takes the next morsel of a job, in which the worker takes part, from the deque of the worker*/
+	bool takeMorsel(unsigned int worker, Task& morsel, unsigned int& participant);
+	/*! \brief moves half of a range of another worker to the deque of the worker*/
+	bool stealTask(unsigned int worker);
+	/*! \brief takes a morsel of job from any deque, used by the thread that submitted the job*/
+	bool takeMorselOfJob(Job& job, Task& morsel);
+	void processMorsel(const Task& morsel, unsigned int participant);
+
+	/*! \brief cores the workers are pinned to, one per worker*/
+	std::vector<int> cores_;
+	std::vector<WorkerQueue> queues_;
+	std::vector<std::thread> workers_;
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_up_;
+	/*! \brief incremented with each submitted job under sleep_mutex_, so idle workers sleep until a new job arrives*/
+	std::atomic<size_t> generation_;
+	std::atomic<bool> stop_;
+	/*! \brief worker whose deque receives the first range of the next job, so concurrent jobs start on different workers*/
+	std::atomic<unsigned int> next_worker_;
+};
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     A TopKHeap keeps the first k (value,TID) pairs w.r.t. a SortOrder in a bounded max-heap.
+ *  \details   Equal values are ordered by ascending TID, so the result equals the first k entries of a stable sort.
+ *             The worst of the k pairs is on top of the heap, so a candidate is rejected in O(1) and accepted in O(log k).
+ */
+template<class T>
+class TopKHeap{
+	public:
+	typedef std::pair<T,TID> Entry;
+
+	TopKHeap(size_t k, SortOrder order) : k_(k), comparator_(order), heap_(){
+		heap_.reserve(k);
+	}
+
+	/*! \brief returns true if a pair (value,tid) would be part of the current top k*/
+	inline bool accepts(const T& value, TID tid) const{
+		if(heap_.size()<k_) return true;
+		if(heap_.empty()) return false;
+		return comparator_.precedes(value,tid,heap_.front().first,heap_.front().second);
+	}
+
+	/*! \brief returns true if the heap holds k pairs*/
+	inline bool full() const{
+		return heap_.size()>=k_;
+	}
+
+	/*! \brief inserts the pair (value,tid), if it belongs to the top k*/
+	inline void push(const T& value, TID tid){
+		if(!accepts(value,tid)) return;
+		if(full()){
+			std::pop_heap(heap_.begin(),heap_.end(),comparator_);
+			heap_.back()=Entry(value,tid);
+		}else{
+			heap_.push_back(Entry(value,tid));
+		}
+		std::push_heap(heap_.begin(),heap_.end(),comparator_);
+	}
+
+	/*! \brief inserts all pairs of another heap, used to merge per thread heaps*/
+	void merge(const TopKHeap<T>& heap){
+		for(size_t i=0;i<heap.heap_.size();++i){
+			push(heap.heap_[i].first,heap.heap_[i].second);
+		}
+	}
+
+	/*! \brief returns the TIDs of the top k in sorted order*/
+	const PositionListPtr getTIDs() const{
+		std::vector<Entry> entries(heap_);
+		std::sort_heap(entries.begin(),entries.end(),comparator_);
+		PositionListPtr tids( new PositionList(entries.size()));
+		for(size_t i=0;i<entries.size();++i){
+			(*tids)[i]=entries[i].second;
+		}
+		return tids;
+	}
+
+	private:
+	struct Comparator{
+		explicit Comparator(SortOrder order) : order_(order){}
+		/*! \brief returns true if (a,tid_a) is placed before (b,tid_b) in the sorted result*/
+		inline bool precedes(const T& a, TID tid_a, const T& b, TID tid_b) const{
+			if(order_==ASCENDING){
+				if(a<b) return true;
+				if(b<a) return false;
+			}else{
+				if(b<a) return true;
+				if(a<b) return false;
+			}
+			return tid_a<tid_b;
+		}
+		inline bool operator() (const Entry& a, const Entry& b) const{
+			return precedes(a.first,a.second,b.first,b.second);
+		}
+		SortOrder order_;
+	};
+
+	size_t k_;
+	Comparator comparator_;
+	std::vector<Entry> heap_;
+};
+
+}; //end namespace CogaDB
+
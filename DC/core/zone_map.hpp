@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <core/global_definitions.hpp>
+#include <core/predicate.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of rows of a segment of a ZoneMap, a multiple of 64, so segments start at a word of a Bitmap*/
+const size_t ZONE_MAP_SEGMENT_SIZE = 64*1024;
+
+/*!
+ *  \brief     A ZoneMap stores the smallest and largest value of each segment of ZONE_MAP_SEGMENT_SIZE rows of a value array,
+ *             so a selection can skip segments that cannot contain a match and copy the TIDs of segments in which every row matches.
+ *  \details   Appended values keep the bounds exact. Updated values only widen the bounds of their segment, so the bounds stay correct,
+ *             but may become loose. Removing rows shifts all following rows to other segments, so the owner has to invalidate the map,
+ *             which rebuilds it with the next call to rebuildIfOutdated. Clustered columns, e.g., loaded in time order, profit the most.
+ *             The bounds cannot describe a NaN, which compares false to every value, so segments containing one are always scanned.
+ */
+template<class T>
+class ZoneMap{
+	public:
+	enum SegmentMatch{NO_MATCH,PARTIAL_MATCH,FULL_MATCH};
+
+	ZoneMap() : minimums_(), maximums_(), contains_nan_(), number_of_rows_(0), valid_(true){}
+
+	/*! \brief updates the bounds for a value appended to the array*/
+	inline void insert(const T& value){
+		if(number_of_rows_%ZONE_MAP_SEGMENT_SIZE==0){
+			minimums_.push_back(value);
+			maximums_.push_back(value);
+			contains_nan_.push_back(false);
+		}else{
+			T& minimum = minimums_.back();
+			T& maximum = maximums_.back();
+			if(value<minimum) minimum=value;
+			if(maximum<value) maximum=value;
+		}
+		if(is_unordered(value,value)) contains_nan_.back()=true;
+		number_of_rows_++;
+	}
+	/*! \brief widens the bounds of the segment of row tid for the new value of the row*/
+	inline void update(TID tid, const T& value){
+		const size_t segment = tid/ZONE_MAP_SEGMENT_SIZE;
+		if(segment>=minimums_.size()) return;
+		if(value<minimums_[segment]) minimums_[segment]=value;
+		if(maximums_[segment]<value) maximums_[segment]=value;
+		if(is_unordered(value,value)) contains_nan_[segment]=true;
+	}
+	void clear(){
+		minimums_.clear();
+		maximums_.clear();
+		contains_nan_.clear();
+		number_of_rows_=0;
+		valid_=true;
+	}
+	/*! \brief marks the bounds as outdated, e.g., after rows were removed or all values were modified*/
+	void invalidate() throw(){ valid_=false; }
+	/*! \brief rebuilds the bounds from the value array, if they are outdated or the array was modified without updating the map*/
+	void rebuildIfOutdated(const std::vector<T>& values){
+		if(valid_ && number_of_rows_==values.size()) return;
+		clear();
+		for(size_t i=0;i<values.size();i++){
+			insert(values[i]);
+		}
+	}
+
+	size_t getNumberOfSegments() const throw(){ return minimums_.size(); }
+	/*! \brief returns whether none, some or all rows of segment may match the predicate*/
+	inline SegmentMatch match(size_t segment, const ValuePredicate<T>& predicate) const{
+		if(contains_nan_[segment]) return PARTIAL_MATCH;
+		if(!predicate.mayMatchRange(minimums_[segment],maximums_[segment])) return NO_MATCH;
+		if(predicate.matchesRange(minimums_[segment],maximums_[segment])) return FULL_MATCH;
+		return PARTIAL_MATCH;
+	}
+
+	private:
+	std::vector<T> minimums_;
+	std::vector<T> maximums_;
+	std::vector<char> contains_nan_;
+	size_t number_of_rows_;
+	bool valid_;
+};
+
+}; //end namespace CogaDB
+
@@ -15,11 +15,19 @@
 #define UNITTEST_HPP
 
 #include <string>
+#include <cmath>
+#include <limits>
+#include <map>
 #include <core/global_definitions.hpp>
 #include <core/base_column.hpp>
 #include <core/column_base_typed.hpp>
 #include <core/column.hpp>
 #include <core/compressed_column.hpp>
+#include <core/conjunctive_scan.hpp>
+#include <core/pipeline.hpp>
+#include <core/task_scheduler.hpp>
+#include <core/expression.hpp>
+#include <core/compact_position_list.hpp>
 
 using namespace CoGaDB;
 
@@ -51,6 +59,17 @@ const std::string get_rand_value() {
 	return s;
 }
 
+/*! \brief returns the operand that negates a value by multiplication, or an empty boost::any for types without arithmetic*/
+template<typename T>
+const boost::any get_negation_operand() {
+	return boost::any(T(-1));
+}
+
+template<>
+const boost::any get_negation_operand<std::string>() {
+	return boost::any();
+}
+
 template<class T>
 void fill_column(boost::shared_ptr<ColumnBaseTyped<T> > col, std::vector<T>& reference_data) {
 	for(unsigned int i = 0;i < reference_data.size(); i++){
@@ -80,6 +99,55 @@ bool equals(std::vector<T> reference_data, boost::shared_ptr<ColumnBaseTyped<T>
 	return true;
 }
 
+template<class T>
+bool equal_aggregates(const boost::any& result, const boost::any& reference) {
+	if (result.empty() || reference.empty()) return result.empty() && reference.empty();
+	if (result.type() != reference.type()) return false;
+	//sums of floating point values depend on the order of the additions
+	if (result.type() == typeid(double)) {
+		double expected = boost::any_cast<double>(reference);
+		return std::fabs(boost::any_cast<double>(result) - expected) <= 1e-6 * (1 + std::fabs(expected));
+	}
+	if (result.type() == typeid(size_t)) return boost::any_cast<size_t>(result) == boost::any_cast<size_t>(reference);
+	if (result.type() == typeid(T)) return boost::any_cast<T>(result) == boost::any_cast<T>(reference);
+	typedef typename AggregationTraits<T>::SumType SumType;
+	if (result.type() == typeid(SumType)) return boost::any_cast<SumType>(result) == boost::any_cast<SumType>(reference);
+	return false;
+}
+
+/*! \brief returns the average of count values with the given sum, strings have no average*/
+template<class SumType>
+double reference_average(const SumType& sum, size_t count) {
+	return double(sum) / count;
+}
+
+double reference_average(const std::string&, size_t) {
+	return 0;
+}
+
+/*! \brief computes an aggregate with plain loops, in the types returned by AggregationState::getResult*/
+template<class T>
+const boost::any reference_aggregate(const std::vector<T>& values, AggregationMethod method) {
+	typedef typename AggregationTraits<T>::SumType SumType;
+	if (method == COUNT) return boost::any(values.size());
+	if (method == MIN || method == MAX) {
+		if (values.empty()) return boost::any();
+		T result = values[0];
+		for (unsigned int i = 1; i < values.size(); i++) {
+			if ((method == MIN && values[i] < result) || (method == MAX && result < values[i])) result = values[i];
+		}
+		return boost::any(result);
+	}
+	if (!AggregationTraits<T>::supports_sum) return boost::any();
+	SumType sum = SumType();
+	for (unsigned int i = 0; i < values.size(); i++) {
+		sum += values[i];
+	}
+	if (method == SUM) return boost::any(sum);
+	if (values.empty()) return boost::any();
+	return boost::any(reference_average(sum, values.size()));
+}
+
 template<class T>
 bool test_column(boost::shared_ptr<ColumnBaseTyped<T> > col, boost::shared_ptr<ColumnBaseTyped<T> > col_new, std::vector<T>& reference_data) {
 	/****** BASIC INSERT TEST ******/
@@ -146,6 +214,1286 @@ bool test_column(boost::shared_ptr<ColumnBaseTyped<T> > col, boost::shared_ptr<C
 		}
 		std::cout << "SUCCESS"<< std::endl;
 	}
+	/****** SORT TEST ******/
+	{
+		std::cout << "SORT TEST: sort column ascending and descending..."; // << std::endl;
+
+		for (int o = 0; o < 2; o++) {
+			SortOrder order = (o == 0) ? ASCENDING : DESCENDING;
+			std::vector<std::pair<T,TID> > reference_sort;
+			for (TID i = 0; i < reference_data.size(); i++) {
+				reference_sort.push_back(std::make_pair(reference_data[i], i));
+			}
+			//stable sort: TIDs of equal values stay in ascending order
+			for (unsigned int i = 1; i < reference_sort.size(); i++) {
+				for (unsigned int j = i; j > 0; j--) {
+					bool out_of_order = (order == ASCENDING) ? (reference_sort[j].first < reference_sort[j-1].first)
+					                                         : (reference_sort[j-1].first < reference_sort[j].first);
+					if (!out_of_order) break;
+					std::swap(reference_sort[j], reference_sort[j-1]);
+				}
+			}
+
+			PositionListPtr tids = col->sort(order);
+			if (!tids || tids->size() != reference_sort.size()) {
+				std::cerr << "SORT TEST FAILED! Invalid result size" << std::endl;
+				return false;
+			}
+			for (unsigned int i = 0; i < tids->size(); i++) {
+				if ((*tids)[i] != reference_sort[i].second) {
+					std::cerr << "SORT TEST FAILED! Unexpected TID on position " << i << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** TOP K TEST ******/
+	{
+		std::cout << "TOP K TEST: compare top k with sorted column..."; // << std::endl;
+
+		unsigned int ks[] = {0, 1, 10, 50, (unsigned int) reference_data.size()};
+		for (int o = 0; o < 2; o++) {
+			SortOrder order = (o == 0) ? ASCENDING : DESCENDING;
+			PositionListPtr sorted = col->sort(order);
+			for (unsigned int i = 0; i < sizeof(ks) / sizeof(ks[0]); i++) {
+				PositionListPtr tids = col->topk(ks[i], order);
+				if (!tids || tids->size() != std::min<size_t>(ks[i], sorted->size())
+					|| !std::equal(tids->begin(), tids->end(), sorted->begin())) {
+					std::cerr << "TOP K TEST FAILED! k=" << ks[i] << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SELECTION TEST ******/
+	{
+		std::cout << "SELECTION TEST: filter column with all value comparators..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+
+		T value = reference_data[0];
+		std::pair<T,T> bounds(std::min(reference_data[1], reference_data[2]), std::max(reference_data[1], reference_data[2]));
+		std::vector<T> value_set;
+		value_set.push_back(reference_data[3]);
+		value_set.push_back(reference_data[4]);
+		value_set.push_back(reference_data[3]);
+
+		ValueComparator comparators[] = {LESSER, GREATER, EQUAL, LESSER_EQUAL, GREATER_EQUAL, NOT_EQUAL, BETWEEN, IN};
+		for (unsigned int c = 0; c < sizeof(comparators) / sizeof(comparators[0]); c++) {
+			ValueComparator comp = comparators[c];
+			boost::any value_for_comparison = value;
+			if (comp == BETWEEN) value_for_comparison = bounds;
+			if (comp == IN) value_for_comparison = value_set;
+
+			PositionList reference_tids;
+			for (TID i = 0; i < reference_data.size(); i++) {
+				const T& x = reference_data[i];
+				bool match = false;
+				switch (comp) {
+					case LESSER: match = x < value; break;
+					case GREATER: match = x > value; break;
+					case EQUAL: match = x == value; break;
+					case LESSER_EQUAL: match = x <= value; break;
+					case GREATER_EQUAL: match = x >= value; break;
+					case NOT_EQUAL: match = x != value; break;
+					case BETWEEN: match = x >= bounds.first && x <= bounds.second; break;
+					case IN: match = std::find(value_set.begin(), value_set.end(), x) != value_set.end(); break;
+					case BLOOM_FILTER: break; //approximate, see BLOOM FILTER TEST
+				}
+				if (match) reference_tids.push_back(i);
+			}
+
+			PositionListPtr results[] = {col->selection(value_for_comparison, comp),
+			                             col->parallel_selection(value_for_comparison, comp, 4),
+			                             plain_col->selection(value_for_comparison, comp),
+			                             plain_col->parallel_selection(value_for_comparison, comp, 4)};
+			for (unsigned int r = 0; r < sizeof(results) / sizeof(results[0]); r++) {
+				if (!results[r] || *results[r] != reference_tids) {
+					std::cerr << "SELECTION TEST FAILED! ValueComparator: " << comp << std::endl;
+					return false;
+				}
+			}
+		}
+		if (std::numeric_limits<T>::has_quiet_NaN) {
+			//a leading NaN must not hide the other values of its block
+			std::vector<T> nan_data(1, std::numeric_limits<T>::quiet_NaN());
+			nan_data.insert(nan_data.end(), reference_data.begin(), reference_data.end());
+			boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+			compressed_col->clearContent();
+			boost::shared_ptr<Column<T> > nan_col (new Column<T>("plain column", col->getType()));
+			for (unsigned int i = 0; i < nan_data.size(); i++) {
+				compressed_col->insert(nan_data[i]);
+				nan_col->insert(nan_data[i]);
+			}
+			ColumnPtr columns[] = {compressed_col, nan_col};
+			ValueComparator nan_comparators[] = {LESSER, GREATER, NOT_EQUAL};
+			for (unsigned int c = 0; c < sizeof(nan_comparators) / sizeof(nan_comparators[0]); c++) {
+				PositionList reference_tids;
+				for (TID i = 0; i < nan_data.size(); i++) {
+					const T& x = nan_data[i];
+					if ((nan_comparators[c] == LESSER && x < value) || (nan_comparators[c] == GREATER && x > value)
+					    || (nan_comparators[c] == NOT_EQUAL && x != value)) reference_tids.push_back(i);
+				}
+				for (unsigned int r = 0; r < sizeof(columns) / sizeof(columns[0]); r++) {
+					if (*columns[r]->selection(value, nan_comparators[c]) != reference_tids
+					    || *columns[r]->bitmap_selection(value, nan_comparators[c])->toPositionList() != reference_tids) {
+						std::cerr << "SELECTION TEST FAILED! Column with a NaN, ValueComparator: " << nan_comparators[c] << std::endl;
+						return false;
+					}
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** CONJUNCTIVE SCAN TEST ******/
+	{
+		std::cout << "CONJUNCTIVE SCAN TEST: evaluate a conjunction of filter conditions..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+
+		T lower = std::min(reference_data[5], reference_data[6]);
+		T upper = std::max(reference_data[5], reference_data[6]);
+
+		ConjunctiveScan scan;
+		scan.addPredicate(col, lower, GREATER_EQUAL);
+		scan.addPredicate(plain_col, upper, LESSER_EQUAL);
+		scan.addPredicate(col, reference_data[7], NOT_EQUAL);
+		PositionListPtr tids = scan.execute();
+
+		PositionList reference_tids;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			if (reference_data[i] >= lower && reference_data[i] <= upper && reference_data[i] != reference_data[7]) {
+				reference_tids.push_back(i);
+			}
+		}
+		if (!tids || *tids != reference_tids) {
+			std::cerr << "CONJUNCTIVE SCAN TEST FAILED!" << std::endl;
+			return false;
+		}
+
+		//the statistics order the condition on x first, but all rows of the first batch pass it, so the following batches run in the other order
+		std::vector<T> sorted_data(reference_data);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		const size_t n = sorted_data.size();
+		boost::shared_ptr<ColumnBaseTyped<T> > x_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		x_col->clearContent();
+		boost::shared_ptr<Column<T> > y_col (new Column<T>("y column", col->getType()));
+		std::vector<T> x_values, y_values;
+		for (size_t i = 0; i < 5 * CONJUNCTIVE_SCAN_BATCH_SIZE; i++) {
+			x_values.push_back(i < CONJUNCTIVE_SCAN_BATCH_SIZE ? sorted_data[n / 2 + i % (n - n / 2)] : sorted_data[i % n]);
+			y_values.push_back(reference_data[i % n]);
+			x_col->insert(x_values.back());
+			y_col->insert(y_values.back());
+		}
+		ConjunctiveScan adaptive_scan;
+		adaptive_scan.addPredicate(y_col, sorted_data[n / 10], GREATER);
+		adaptive_scan.addPredicate(x_col, sorted_data[n / 2], GREATER_EQUAL);
+		tids = adaptive_scan.execute();
+		reference_tids.clear();
+		for (TID i = 0; i < x_values.size(); i++) {
+			if (y_values[i] > sorted_data[n / 10] && x_values[i] >= sorted_data[n / 2]) reference_tids.push_back(i);
+		}
+		if (!tids || *tids != reference_tids) {
+			std::cerr << "CONJUNCTIVE SCAN TEST FAILED! Reordered conditions" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** BITMAP TEST ******/
+	{
+		std::cout << "BITMAP TEST: filter column into bitmaps, combine them and remove the selected rows..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+
+		T lower = std::min(reference_data[8], reference_data[9]);
+		T upper = std::max(reference_data[8], reference_data[9]);
+		PositionList lower_tids, upper_tids, range_tids, remaining_tids;
+		std::vector<T> remaining_data;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			if (reference_data[i] >= lower) lower_tids.push_back(i);
+			if (reference_data[i] <= upper) upper_tids.push_back(i);
+			if (reference_data[i] >= lower && reference_data[i] <= upper) {
+				range_tids.push_back(i);
+			} else {
+				remaining_tids.push_back(i);
+				remaining_data.push_back(reference_data[i]);
+			}
+		}
+
+		BitmapPtr lower_bitmap = col->bitmap_selection(lower, GREATER_EQUAL);
+		BitmapPtr upper_bitmap = plain_col->bitmap_selection(upper, LESSER_EQUAL);
+		if (*lower_bitmap->toPositionList() != lower_tids || *upper_bitmap->toPositionList() != upper_tids) {
+			std::cerr << "BITMAP TEST FAILED! Invalid bitmap selection" << std::endl;
+			return false;
+		}
+		BitmapPtr range_bitmap (new Bitmap(*lower_bitmap));
+		*range_bitmap &= *upper_bitmap;
+		Bitmap remaining_bitmap(*range_bitmap);
+		remaining_bitmap.flip();
+		Bitmap all_bitmap(remaining_bitmap);
+		all_bitmap |= *range_bitmap;
+		if (*range_bitmap->toPositionList() != range_tids || range_bitmap->count() != range_tids.size()
+			|| *remaining_bitmap.toPositionList() != remaining_tids || !(all_bitmap == Bitmap(reference_data.size(), true))) {
+			std::cerr << "BITMAP TEST FAILED! Invalid result of AND/OR/NOT" << std::endl;
+			return false;
+		}
+
+		//the first selection yields a PositionList, later ones adapt to the observed selectivity
+		for (unsigned int i = 0; i < 3; i++) {
+			SelectionResult result = col->adaptive_selection(reference_data[i], NOT_EQUAL);
+			if (*result.getPositionList() != *col->selection(reference_data[i], NOT_EQUAL)) {
+				std::cerr << "BITMAP TEST FAILED! Invalid adaptive selection" << std::endl;
+				return false;
+			}
+		}
+
+		ColumnPtr columns[] = {col->copy(), plain_col->copy()};
+		for (unsigned int c = 0; c < sizeof(columns) / sizeof(columns[0]); c++) {
+			if (!columns[c]->remove(range_bitmap)
+				|| !equals(remaining_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(columns[c]))
+				|| columns[c]->size() != remaining_data.size()) {
+				std::cerr << "BITMAP TEST FAILED! Invalid remove" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** AGGREGATION TEST ******/
+	{
+		std::cout << "AGGREGATION TEST: aggregate column, position list and bitmap..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+
+		PositionListPtr tids (new PositionList());
+		std::vector<T> selected_data;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			if (i % 3 == 0) {
+				tids->push_back(i);
+				selected_data.push_back(reference_data[i]);
+			}
+		}
+		BitmapPtr bitmap = Bitmap::fromPositionList(*tids, reference_data.size());
+
+		AggregationMethod methods[] = {SUM, MIN, MAX, COUNT, AVG};
+		for (unsigned int m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+			ColumnPtr columns[] = {col, plain_col};
+			for (unsigned int c = 0; c < sizeof(columns) / sizeof(columns[0]); c++) {
+				if (!equal_aggregates<T>(columns[c]->aggregate(methods[m]), reference_aggregate(reference_data, methods[m]))
+					|| !equal_aggregates<T>(columns[c]->aggregate(methods[m], tids), reference_aggregate(selected_data, methods[m]))
+					|| !equal_aggregates<T>(columns[c]->aggregate(methods[m], bitmap), reference_aggregate(selected_data, methods[m]))) {
+					std::cerr << "AGGREGATION TEST FAILED! AggregationMethod: " << methods[m] << std::endl;
+					return false;
+				}
+			}
+		}
+		if (std::numeric_limits<T>::has_quiet_NaN) {
+			//a NaN does not bound the values, so the minimum and maximum ignore it
+			boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+			compressed_col->clearContent();
+			boost::shared_ptr<Column<T> > nan_col (new Column<T>("plain column", col->getType()));
+			compressed_col->insert(std::numeric_limits<T>::quiet_NaN());
+			nan_col->insert(std::numeric_limits<T>::quiet_NaN());
+			for (unsigned int i = 0; i < reference_data.size(); i++) {
+				compressed_col->insert(reference_data[i]);
+				nan_col->insert(reference_data[i]);
+			}
+			BitmapPtr all_rows (new Bitmap(reference_data.size() + 1, true));
+			ColumnPtr columns[] = {compressed_col, nan_col};
+			AggregationMethod bound_methods[] = {MIN, MAX};
+			for (unsigned int c = 0; c < sizeof(columns) / sizeof(columns[0]); c++) {
+				for (unsigned int m = 0; m < sizeof(bound_methods) / sizeof(bound_methods[0]); m++) {
+					if (!equal_aggregates<T>(columns[c]->aggregate(bound_methods[m]), reference_aggregate(reference_data, bound_methods[m]))
+					    || !equal_aggregates<T>(columns[c]->aggregate(bound_methods[m], all_rows), reference_aggregate(reference_data, bound_methods[m]))) {
+						std::cerr << "AGGREGATION TEST FAILED! Column with a NaN, AggregationMethod: " << bound_methods[m] << std::endl;
+						return false;
+					}
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** GROUP BY TEST ******/
+	{
+		std::cout << "GROUP BY TEST: group column by keys with hash and sort based algorithm..."; // << std::endl;
+
+		//group the reversed values by the values of the column
+		std::vector<T> values(reference_data.rbegin(), reference_data.rend());
+		boost::shared_ptr<Column<T> > value_col (new Column<T>("value column", col->getType()));
+		value_col->insert(values.begin(), values.end());
+
+		std::map<T, AggregationState<T> > reference_groups;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			reference_groups[reference_data[i]].add(values[i]);
+		}
+
+		GroupByAlgorithm algorithms[] = {HASH_BASED_GROUP_BY, SORT_BASED_GROUP_BY, AUTO_GROUP_BY};
+		for (unsigned int a = 0; a < sizeof(algorithms) / sizeof(algorithms[0]); a++) {
+			ColumnPairPtr count_result = value_col->aggregate_by_keys(col, COUNT, algorithms[a]);
+			ColumnPairPtr min_result = value_col->aggregate_by_keys(col, MIN, algorithms[a]);
+			if (!count_result || !min_result || count_result->first->size() != reference_groups.size() || min_result->first->size() != reference_groups.size()) {
+				std::cerr << "GROUP BY TEST FAILED! Invalid number of groups for GroupByAlgorithm: " << algorithms[a] << std::endl;
+				return false;
+			}
+			for (TID i = 0; i < reference_groups.size(); i++) {
+				const AggregationState<T>& count_group = reference_groups[boost::any_cast<T>(count_result->first->get(i))];
+				const AggregationState<T>& min_group = reference_groups[boost::any_cast<T>(min_result->first->get(i))];
+				if (boost::any_cast<int>(count_result->second->get(i)) != int(count_group.getCount())
+					|| boost::any_cast<T>(min_result->second->get(i)) != boost::any_cast<T>(min_group.getResult(MIN))) {
+					std::cerr << "GROUP BY TEST FAILED! Invalid aggregate for GroupByAlgorithm: " << algorithms[a] << std::endl;
+					return false;
+				}
+			}
+		}
+		//the sum of the group does not fit into the aggregate column, the maximum does
+		if (AggregationTraits<T>::supports_sum) {
+			boost::shared_ptr<Column<T> > large_col (new Column<T>("large column", col->getType()));
+			boost::shared_ptr<Column<T> > key_col (new Column<T>("key column", col->getType()));
+			for (unsigned int i = 0; i < 2; i++) {
+				large_col->insert(std::numeric_limits<T>::max());
+				key_col->insert(reference_data[0]);
+			}
+			if (large_col->aggregate_by_keys(key_col, SUM) || !large_col->aggregate_by_keys(key_col, MAX)) {
+				std::cerr << "GROUP BY TEST FAILED! Overflow of aggregate" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** CONSTANT ARITHMETIC TEST ******/
+	{
+		std::cout << "CONSTANT ARITHMETIC TEST: add, substract, multiply and divide column by a constant..."; // << std::endl;
+
+		T value = reference_data[1];
+		ColumnAlgebraOperation operations[] = {ADD, SUB, MUL, DIV};
+		for (unsigned int o = 0; o < sizeof(operations) / sizeof(operations[0]); o++) {
+			ColumnAlgebraOperation op = operations[o];
+			ColumnPtr column = col->copy();
+			bool success = false;
+			switch (op) {
+				case ADD: success = column->add(value); break;
+				case SUB: success = column->minus(value); break;
+				case MUL: success = column->multiply(value); break;
+				case DIV: success = column->division(value); break;
+			}
+
+			std::vector<T> expected_data(reference_data);
+			bool expected_success = is_valid_operand(op, value);
+			if (expected_success) {
+				for (unsigned int i = 0; i < expected_data.size(); i++) {
+					apply_operation(expected_data[i], op, value);
+				}
+			}
+			if (success != expected_success || !equals(expected_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(column))) {
+				std::cerr << "CONSTANT ARITHMETIC TEST FAILED! ColumnAlgebraOperation: " << op << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** COLUMN ALGEBRA TEST ******/
+	{
+		std::cout << "COLUMN ALGEBRA TEST: combine two columns and write results into new columns..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+		std::vector<T> operand_data(reference_data.rbegin(), reference_data.rend());
+		boost::shared_ptr<Column<T> > operand_plain_col (new Column<T>("operand column", col->getType()));
+		operand_plain_col->insert(operand_data.begin(), operand_data.end());
+		ColumnPtr operand_col = operand_plain_col;
+
+		T value = reference_data[1];
+		ColumnAlgebraOperation operations[] = {ADD, SUB, MUL, DIV};
+		for (unsigned int o = 0; o < sizeof(operations) / sizeof(operations[0]); o++) {
+			ColumnAlgebraOperation op = operations[o];
+
+			std::vector<T> expected_data(reference_data);
+			bool expected_success = is_valid_operand_array(op, &operand_data[0], operand_data.size());
+			if (expected_success) {
+				for (unsigned int i = 0; i < expected_data.size(); i++) {
+					apply_operation(expected_data[i], op, operand_data[i]);
+				}
+			}
+			std::vector<T> expected_constant_data(reference_data);
+			bool expected_constant_success = is_valid_operand(op, value);
+			if (expected_constant_success) {
+				for (unsigned int i = 0; i < expected_constant_data.size(); i++) {
+					apply_operation(expected_constant_data[i], op, value);
+				}
+			}
+
+			ColumnPtr columns[] = {col->copy(), plain_col->copy()};
+			for (unsigned int c = 0; c < 2; c++) {
+				bool success = false;
+				switch (op) {
+					case ADD: success = columns[c]->add(operand_col); break;
+					case SUB: success = columns[c]->minus(operand_col); break;
+					case MUL: success = columns[c]->multiply(operand_col); break;
+					case DIV: success = columns[c]->division(operand_col); break;
+				}
+				if (success != expected_success || !equals(expected_success ? expected_data : reference_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(columns[c]))) {
+					std::cerr << "COLUMN ALGEBRA TEST FAILED! In place operation, ColumnAlgebraOperation: " << op << std::endl;
+					return false;
+				}
+			}
+
+			ColumnPtr inputs[] = {col, plain_col};
+			for (unsigned int c = 0; c < 2; c++) {
+				ColumnPtr result = inputs[c]->column_algebra_operation(operand_col, op);
+				if ((result != NULL) != expected_success || (result && !equals(expected_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(result)))) {
+					std::cerr << "COLUMN ALGEBRA TEST FAILED! Operation with column, ColumnAlgebraOperation: " << op << std::endl;
+					return false;
+				}
+				result = inputs[c]->column_algebra_operation(boost::any(value), op);
+				if ((result != NULL) != expected_constant_success || (result && !equals(expected_constant_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(result)))) {
+					std::cerr << "COLUMN ALGEBRA TEST FAILED! Operation with constant, ColumnAlgebraOperation: " << op << std::endl;
+					return false;
+				}
+				if (!equals(reference_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(inputs[c]))) {
+					std::cerr << "COLUMN ALGEBRA TEST FAILED! Input column was modified, ColumnAlgebraOperation: " << op << std::endl;
+					return false;
+				}
+			}
+		}
+
+		//negating a sorted column reverses its order, so the result must not be trusted as sorted
+		std::vector<T> sorted_data(reference_data);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		boost::shared_ptr<ColumnBaseTyped<T> > sorted_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		sorted_col->clearContent();
+		for (unsigned int i = 0; i < sorted_data.size(); i++) {
+			sorted_col->insert(sorted_data[i]);
+		}
+		ColumnPtr negated_col = sorted_col->column_algebra_operation(get_negation_operand<T>(), MUL);
+		if (negated_col) {
+			std::vector<T> negated_data(sorted_data);
+			std::vector<std::pair<T, TID> > sorted_pairs;
+			for (unsigned int i = 0; i < negated_data.size(); i++) {
+				apply_operation(negated_data[i], MUL, boost::any_cast<T>(get_negation_operand<T>()));
+				sorted_pairs.push_back(std::make_pair(negated_data[i], TID(i)));
+			}
+			std::stable_sort(sorted_pairs.begin(), sorted_pairs.end(), [](const std::pair<T, TID>& a, const std::pair<T, TID>& b) { return a.first < b.first; });
+			PositionList expected_sorted_tids;
+			for (unsigned int i = 0; i < sorted_pairs.size(); i++) expected_sorted_tids.push_back(sorted_pairs[i].second);
+			const T threshold = negated_data[negated_data.size() / 3];
+			PositionList expected_tids;
+			for (unsigned int i = 0; i < negated_data.size(); i++) {
+				if (negated_data[i] < threshold) expected_tids.push_back(i);
+			}
+			if (*negated_col->selection(threshold, LESSER) != expected_tids || *negated_col->sort(ASCENDING) != expected_sorted_tids) {
+				std::cerr << "COLUMN ALGEBRA TEST FAILED! Negated sorted column" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** EXPRESSION TEST ******/
+	{
+		std::cout << "EXPRESSION TEST: evaluate (col*plain_col)+col/constant in a single pass..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+		T value = reference_data[1];
+
+		typedef typename Expression<T>::ExpressionPtr ExpressionPtr;
+		ExpressionPtr expression = Expression<T>::operation(ADD,
+			Expression<T>::operation(MUL, Expression<T>::column(col), Expression<T>::column(plain_col)),
+			Expression<T>::operation(DIV, Expression<T>::column(col), Expression<T>::constant(value)));
+		ColumnPtr result = expression->evaluate();
+
+		std::vector<T> expected_data(reference_data);
+		bool expected_success = is_valid_operand(DIV, value);
+		for (unsigned int i = 0; i < expected_data.size() && expected_success; i++) {
+			T quotient = reference_data[i];
+			apply_operation(expected_data[i], MUL, reference_data[i]);
+			apply_operation(quotient, DIV, value);
+			apply_operation(expected_data[i], ADD, quotient);
+		}
+		if ((result != NULL) != expected_success || (result && !equals(expected_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(result)))
+		    || !equals(reference_data, col) || !equals(reference_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(plain_col))) {
+			std::cerr << "EXPRESSION TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** GATHER TEST ******/
+	{
+		std::cout << "GATHER TEST: fetch values by position list and bitmap into a new column..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+
+		PositionListPtr random_tids (new PositionList());
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			random_tids->push_back(rand() % reference_data.size());
+		}
+		PositionListPtr dense_tids (new PositionList());
+		for (unsigned int i = reference_data.size() / 4; i < reference_data.size() / 2; i++) {
+			dense_tids->push_back(i);
+		}
+		BitmapPtr bitmap = Bitmap::fromPositionList(*random_tids, reference_data.size());
+		PositionListPtr invalid_tids (new PositionList(1, reference_data.size()));
+
+		PositionListPtr position_lists[] = {random_tids, dense_tids, bitmap->toPositionList()};
+		ColumnPtr columns[] = {col, plain_col};
+		for (unsigned int c = 0; c < 2; c++) {
+			for (unsigned int p = 0; p < 3; p++) {
+				std::vector<T> expected_data;
+				for (unsigned int i = 0; i < position_lists[p]->size(); i++) {
+					expected_data.push_back(reference_data[(*position_lists[p])[i]]);
+				}
+				ColumnPtr result = (p < 2) ? columns[c]->gather(position_lists[p]) : columns[c]->gather(bitmap);
+				if (!result || !result->isMaterialized() || result->size() != expected_data.size()
+				    || !equals(expected_data, shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(result))) {
+					std::cerr << "GATHER TEST FAILED! Column: " << columns[c]->getName() << " Position list: " << p << std::endl;
+					return false;
+				}
+			}
+			if (columns[c]->gather(invalid_tids)) {
+				std::cerr << "GATHER TEST FAILED! TID out of range was accepted" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** COMPACT POSITION LIST TEST ******/
+	{
+		std::cout << "COMPACT POSITION LIST TEST: store ranges, sorted and unsorted TIDs compactly..."; // << std::endl;
+
+		PositionListPtr range_tids (new PositionList());
+		for (unsigned int i = 10; i < reference_data.size(); i++) {
+			range_tids->push_back(i);
+		}
+		PositionListPtr sorted_tids = col->sort(ASCENDING);
+		std::sort(sorted_tids->begin(), sorted_tids->end());
+		sorted_tids->erase(sorted_tids->begin() + sorted_tids->size() / 2);
+		PositionListPtr unsorted_tids (new PositionList(sorted_tids->rbegin(), sorted_tids->rend()));
+
+		PositionListPtr position_lists[] = {range_tids, sorted_tids, unsorted_tids};
+		CompactPositionList::Representation expected_representations[] = {CompactPositionList::RANGE, CompactPositionList::FRAME_OF_REFERENCE, CompactPositionList::PLAIN};
+		for (unsigned int p = 0; p < 3; p++) {
+			CompactPositionList compact_tids(*position_lists[p]);
+			if (compact_tids.getRepresentation() != expected_representations[p] || compact_tids.size() != position_lists[p]->size()
+			    || *compact_tids.toPositionList() != *position_lists[p]) {
+				std::cerr << "COMPACT POSITION LIST TEST FAILED! Position list: " << p << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SEMI AND ANTI JOIN TEST ******/
+	{
+		std::cout << "SEMI AND ANTI JOIN TEST: find rows with and without a join partner..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+		//every key occurs twice, so a join would return duplicates
+		boost::shared_ptr<Column<T> > key_col (new Column<T>("key column", col->getType()));
+		key_col->insert(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		key_col->insert(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		std::vector<T> keys(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		std::sort(keys.begin(), keys.end());
+
+		PositionList expected_semi_join_tids;
+		PositionList expected_anti_join_tids;
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			if (std::binary_search(keys.begin(), keys.end(), reference_data[i])) {
+				expected_semi_join_tids.push_back(i);
+			} else {
+				expected_anti_join_tids.push_back(i);
+			}
+		}
+		ColumnPtr columns[] = {col, plain_col};
+		for (unsigned int c = 0; c < 2; c++) {
+			if (*columns[c]->semi_join(key_col) != expected_semi_join_tids || *columns[c]->anti_join(key_col) != expected_anti_join_tids) {
+				std::cerr << "SEMI AND ANTI JOIN TEST FAILED! Column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+		}
+		//every row of key_col finds its partner in the compressed column
+		if (key_col->semi_join(col)->size() != key_col->size() || !key_col->anti_join(col)->empty()) {
+			std::cerr << "SEMI AND ANTI JOIN TEST FAILED! Compressed join column" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** BLOOM FILTER TEST ******/
+	{
+		std::cout << "BLOOM FILTER TEST: filter the probe side of a hash join with a bloom filter of the build side..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		plain_col->insert(reference_data.begin(), reference_data.end());
+		boost::shared_ptr<Column<T> > build_col (new Column<T>("build column", col->getType()));
+		build_col->insert(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		BitmapPtr build_filter (new Bitmap(build_col->size()));
+		std::vector<T> keys;
+		for (unsigned int i = 0; i < build_col->size(); i += 2) {
+			build_filter->set(i);
+			keys.push_back(reference_data[i]);
+		}
+
+		boost::any bloom_filter = build_col->createBloomFilter(build_filter);
+		ColumnPtr columns[] = {col, plain_col};
+		for (unsigned int c = 0; c < 2; c++) {
+			BitmapPtr probe_filter = columns[c]->bitmap_selection(bloom_filter, BLOOM_FILTER);
+			PositionListPtr probe_tids = columns[c]->selection(bloom_filter, BLOOM_FILTER);
+			//a bloom filter may return false positives, but must not miss a key
+			bool missed_key = false;
+			for (unsigned int i = 0; i < reference_data.size(); i++) {
+				if (std::find(keys.begin(), keys.end(), reference_data[i]) != keys.end() && !probe_filter->test(i)) missed_key = true;
+			}
+			PositionListPairPtr expected_join_tids = build_col->hash_join(columns[c], build_filter, BitmapPtr());
+			PositionListPairPtr join_tids = build_col->hash_join(columns[c], build_filter, probe_filter);
+			//the result is ordered by the TIDs of the probe side
+			std::vector<TID_Pair> reference_join_tids;
+			for (unsigned int i = 0; i < reference_data.size(); i++) {
+				for (unsigned int j = 0; j < build_col->size(); j++) {
+					if (build_filter->test(j) && reference_data[i] == reference_data[j]) reference_join_tids.push_back(TID_Pair(j, i));
+				}
+			}
+			std::vector<TID_Pair> filtered_join_tids;
+			for (unsigned int i = 0; i < join_tids->first->size() && i < join_tids->second->size(); i++) {
+				filtered_join_tids.push_back(TID_Pair((*join_tids->first)[i], (*join_tids->second)[i]));
+			}
+			if (missed_key || *probe_tids != *probe_filter->toPositionList() || filtered_join_tids != reference_join_tids
+			    || *join_tids->first != *expected_join_tids->first || *join_tids->second != *expected_join_tids->second) {
+				std::cerr << "BLOOM FILTER TEST FAILED! Column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+		}
+		if (std::numeric_limits<T>::has_quiet_NaN) {
+			//a leading NaN key must not disable the range of the filter
+			const T smallest = *std::min_element(reference_data.begin(), reference_data.end());
+			const T largest = *std::max_element(reference_data.begin(), reference_data.end());
+			BloomFilter<T> filter(2);
+			filter.insert(std::numeric_limits<T>::quiet_NaN());
+			filter.insert(smallest);
+			if (!filter.mayContainRange(smallest, smallest) || (smallest < largest && filter.mayContainRange(largest, largest))) {
+				std::cerr << "BLOOM FILTER TEST FAILED! Key range with a NaN" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** JOIN TEST ******/
+	{
+		std::cout << "JOIN TEST: join columns with every join algorithm..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > key_col (new Column<T>("key column", col->getType()));
+		key_col->insert(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		key_col->insert(reference_data.begin(), reference_data.begin() + reference_data.size() / 3);
+		std::vector<TID_Pair> expected_join_tids;
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			for (unsigned int j = 0; j < key_col->size(); j++) {
+				if (reference_data[i] == (*key_col)[j]) expected_join_tids.push_back(TID_Pair(i, j));
+			}
+		}
+		std::sort(expected_join_tids.begin(), expected_join_tids.end());
+
+		JoinAlgorithm algorithms[] = {AUTO_JOIN, HASH_JOIN, SORT_MERGE_JOIN, NESTED_LOOP_JOIN};
+		for (unsigned int a = 0; a < 4; a++) {
+			//the larger column is the build side in one direction and the probe side in the other
+			PositionListPairPtr join_results[] = {col->join(key_col, algorithms[a]), key_col->join(col, algorithms[a])};
+			for (unsigned int r = 0; r < 2; r++) {
+				const PositionList& tids = (r == 0) ? *join_results[r]->first : *join_results[r]->second;
+				const PositionList& key_tids = (r == 0) ? *join_results[r]->second : *join_results[r]->first;
+				std::vector<TID_Pair> join_tids;
+				for (unsigned int i = 0; i < tids.size() && i < key_tids.size(); i++) {
+					join_tids.push_back(TID_Pair(tids[i], key_tids[i]));
+				}
+				std::sort(join_tids.begin(), join_tids.end());
+				if (tids.size() != key_tids.size() || join_tids != expected_join_tids) {
+					std::cerr << "JOIN TEST FAILED! Algorithm: " << algorithms[a] << " Direction: " << r << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** COLUMN STATISTICS TEST ******/
+	{
+		std::cout << "COLUMN STATISTICS TEST: maintain statistics on insert, update and remove..."; // << std::endl;
+
+		std::vector<T> sorted_data(reference_data);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		std::vector<T> distinct_values(sorted_data);
+		distinct_values.erase(std::unique(distinct_values.begin(), distinct_values.end()), distinct_values.end());
+		const T& median = sorted_data[sorted_data.size() / 2];
+		const double fraction_lesser_than_median = double(std::lower_bound(sorted_data.begin(), sorted_data.end(), median) - sorted_data.begin()) / sorted_data.size();
+
+		boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		compressed_col->clearContent();
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		for (unsigned int i = 0; i < sorted_data.size(); i++) {
+			compressed_col->insert(sorted_data[i]);
+			plain_col->insert(sorted_data[i]);
+		}
+		ColumnPtr columns[] = {compressed_col, plain_col};
+		for (unsigned int c = 0; c < 2; c++) {
+			const ColumnStatistics& statistics = columns[c]->getColumnStatistics();
+			double estimated_distinct_values = statistics.getNumberOfDistinctValues();
+			if (statistics.getNumberOfRows() != sorted_data.size() || !statistics.isSortedAscending()
+			    || boost::any_cast<T>(statistics.getMinimum()) != sorted_data.front() || boost::any_cast<T>(statistics.getMaximum()) != sorted_data.back()
+			    || std::abs(estimated_distinct_values - distinct_values.size()) > 0.1 * distinct_values.size() + 1
+			    || statistics.estimateSelectivity(sorted_data.front(), LESSER) != 0.0 || statistics.estimateSelectivity(sorted_data.front(), GREATER_EQUAL) != 1.0
+			    || std::abs(statistics.estimateSelectivity(median, LESSER) - fraction_lesser_than_median) > 0.1) {
+				std::cerr << "COLUMN STATISTICS TEST FAILED! Column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+			//the largest value in front and the smallest value at the end break the order
+			columns[c]->update(TID(2), boost::any(sorted_data.back()));
+			columns[c]->insert(boost::any(sorted_data.front()));
+			columns[c]->remove(TID(1));
+			const ColumnStatistics& updated_statistics = columns[c]->getColumnStatistics();
+			if (updated_statistics.getNumberOfRows() != columns[c]->size() || updated_statistics.getNumberOfRows() != sorted_data.size()
+			    || (sorted_data.front() < sorted_data.back() && updated_statistics.isSortedAscending())
+			    || boost::any_cast<T>(updated_statistics.getMinimum()) != sorted_data.front() || boost::any_cast<T>(updated_statistics.getMaximum()) != sorted_data.back()) {
+				std::cerr << "COLUMN STATISTICS TEST FAILED! Modified column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SORTED COLUMN TEST ******/
+	{
+		std::cout << "SORTED COLUMN TEST: search sorted columns instead of scanning them..."; // << std::endl;
+
+		std::vector<T> ascending_data(reference_data);
+		std::sort(ascending_data.begin(), ascending_data.end());
+		std::vector<T> descending_data(ascending_data.rbegin(), ascending_data.rend());
+		const std::vector<T>* data[] = {&ascending_data, &descending_data};
+		const size_t n = ascending_data.size();
+		boost::any comparison_values[] = {ascending_data[n / 2], ascending_data.front(), ascending_data.back(), std::make_pair(ascending_data[n / 4], ascending_data[3 * n / 4])};
+		ValueComparator comparators[] = {EQUAL, LESSER, LESSER_EQUAL, GREATER, GREATER_EQUAL, BETWEEN};
+
+		for (unsigned int d = 0; d < 2; d++) {
+			boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+			compressed_col->clearContent();
+			boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+			for (unsigned int i = 0; i < n; i++) {
+				compressed_col->insert((*data[d])[i]);
+				plain_col->insert((*data[d])[i]);
+			}
+			ColumnPtr columns[] = {compressed_col, plain_col};
+			for (unsigned int c = 0; c < 2; c++) {
+				for (unsigned int step = 0; step < 2; step++) {
+					const ColumnStatistics& statistics = columns[c]->getColumnStatistics();
+					const bool expect_sorted = (step == 0) && ascending_data.front() < ascending_data.back();
+					if (expect_sorted && (statistics.isSortedAscending() != (d == 0) || statistics.isSortedDescending() != (d == 1))) {
+						std::cerr << "SORTED COLUMN TEST FAILED! Sortedness of column: " << columns[c]->getName() << std::endl;
+						return false;
+					}
+					for (unsigned int v = 0; v < 4; v++) {
+						for (unsigned int p = 0; p < 6; p++) {
+							if ((v == 3) != (comparators[p] == BETWEEN)) continue;
+							ValuePredicate<T> predicate(comparison_values[v], comparators[p]);
+							PositionList expected_tids;
+							for (unsigned int i = 0; i < n; i++) {
+								if (predicate((step == 0 || i != 1) ? (*data[d])[i] : data[d]->back())) expected_tids.push_back(i);
+							}
+							if (*columns[c]->selection(comparison_values[v], comparators[p]) != expected_tids
+							    || *columns[c]->bitmap_selection(comparison_values[v], comparators[p])->toPositionList() != expected_tids) {
+								std::cerr << "SORTED COLUMN TEST FAILED! Column: " << columns[c]->getName() << " Comparator: " << comparators[p] << " Step: " << step << std::endl;
+								return false;
+							}
+						}
+					}
+					if (step == 0) {
+						//a sorted column is its own sort order
+						PositionListPtr sorted_tids = columns[c]->sort(d == 0 ? ASCENDING : DESCENDING);
+						bool in_tid_order = sorted_tids->size() == n;
+						for (unsigned int i = 0; i < sorted_tids->size() && in_tid_order; i++) {
+							in_tid_order = (*sorted_tids)[i] == i;
+						}
+						if (!in_tid_order) {
+							std::cerr << "SORTED COLUMN TEST FAILED! Sort of column: " << columns[c]->getName() << std::endl;
+							return false;
+						}
+						//an update that breaks the order
+						columns[c]->update(TID(1), boost::any(data[d]->back()));
+					}
+				}
+			}
+		}
+		if (std::numeric_limits<T>::has_quiet_NaN) {
+			//a NaN compares false to every value, so (largest, NaN, smallest) is sorted in neither order
+			const T nan_data[] = {ascending_data.back(), std::numeric_limits<T>::quiet_NaN(), ascending_data.front()};
+			boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+			compressed_col->clearContent();
+			boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+			for (unsigned int i = 0; i < 3; i++) {
+				compressed_col->insert(nan_data[i]);
+				plain_col->insert(nan_data[i]);
+			}
+			ColumnPtr columns[] = {compressed_col, plain_col};
+			PositionList expected_lesser(1, 2);
+			//NaNs are sorted behind all other values
+			const TID ascending_tids[] = {2, 0, 1};
+			const TID descending_tids[] = {1, 0, 2};
+			for (unsigned int c = 0; c < 2; c++) {
+				const ColumnStatistics& statistics = columns[c]->getColumnStatistics();
+				if (statistics.isSortedAscending() || statistics.isSortedDescending()
+				    || *columns[c]->selection(nan_data[0], LESSER) != expected_lesser
+				    || *columns[c]->sort(ASCENDING) != PositionList(ascending_tids, ascending_tids + 3)
+				    || *columns[c]->sort(DESCENDING) != PositionList(descending_tids, descending_tids + 3)) {
+					std::cerr << "SORTED COLUMN TEST FAILED! Column with a NaN: " << columns[c]->getName() << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** ZONE MAP TEST ******/
+	{
+		std::cout << "ZONE MAP TEST: skip segments of a plain column that cannot match..."; // << std::endl;
+
+		std::vector<T> sorted_data(reference_data);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		const size_t n = sorted_data.size();
+		//each segment cycles through its own third of the values, the last segment is partially filled
+		std::vector<T> values;
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		for (size_t i = 0; i < 3 * ZONE_MAP_SEGMENT_SIZE + 100; i++) {
+			const size_t segment = std::min<size_t>(i / ZONE_MAP_SEGMENT_SIZE, 2);
+			const size_t begin = segment * n / 3;
+			const size_t end = (segment + 1) * n / 3;
+			values.push_back(sorted_data[begin + i % (end - begin)]);
+			plain_col->insert(values.back());
+		}
+		boost::any comparison_values[] = {sorted_data[n / 3], sorted_data.front(), sorted_data.back(), std::make_pair(sorted_data.front(), sorted_data[n / 3 - 1])};
+		ValueComparator comparators[] = {EQUAL, NOT_EQUAL, LESSER, LESSER_EQUAL, GREATER, GREATER_EQUAL, BETWEEN};
+
+		for (unsigned int step = 0; step < 3; step++) {
+			for (unsigned int v = 0; v < 4; v++) {
+				for (unsigned int p = 0; p < 7; p++) {
+					if ((v == 3) != (comparators[p] == BETWEEN)) continue;
+					ValuePredicate<T> predicate(comparison_values[v], comparators[p]);
+					PositionList expected_tids;
+					for (unsigned int i = 0; i < values.size(); i++) {
+						if (predicate(values[i])) expected_tids.push_back(i);
+					}
+					if (*plain_col->selection(comparison_values[v], comparators[p]) != expected_tids
+					    || *plain_col->bitmap_selection(comparison_values[v], comparators[p])->toPositionList() != expected_tids) {
+						std::cerr << "ZONE MAP TEST FAILED! Comparator: " << comparators[p] << " Step: " << step << std::endl;
+						return false;
+					}
+				}
+			}
+			if (step == 0) {
+				//widens the bounds of the first segment
+				values[5] = sorted_data.back();
+				plain_col->update(TID(5), boost::any(values[5]));
+			} else if (step == 1) {
+				//moves rows to other segments
+				values.erase(values.begin());
+				plain_col->remove(TID(0));
+			}
+		}
+		if (std::numeric_limits<T>::has_quiet_NaN) {
+			//a leading NaN must not hide the other values of its segment
+			boost::shared_ptr<Column<T> > nan_col (new Column<T>("plain column", col->getType()));
+			nan_col->insert(std::numeric_limits<T>::quiet_NaN());
+			PositionList expected_tids;
+			for (size_t i = 1; i <= ZONE_MAP_SEGMENT_SIZE; i++) {
+				nan_col->insert(sorted_data.front());
+				expected_tids.push_back(i);
+			}
+			if (*nan_col->selection(sorted_data.back(), LESSER) != expected_tids
+			    || *nan_col->bitmap_selection(sorted_data.back(), LESSER)->toPositionList() != expected_tids) {
+				std::cerr << "ZONE MAP TEST FAILED! Column with a NaN" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SORTED INDEX TEST ******/
+	{
+		std::cout << "SORTED INDEX TEST: look up rows in a sorted index and maintain it on modification..."; // << std::endl;
+
+		//enough rows for several levels of the index
+		std::vector<T> values;
+		for (unsigned int i = 0; i < 50; i++) {
+			values.insert(values.end(), reference_data.begin(), reference_data.end());
+		}
+		std::vector<T> sorted_data(values);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		const size_t n = sorted_data.size();
+		std::vector<T> in_values;
+		in_values.push_back(sorted_data[n / 3]);
+		in_values.push_back(sorted_data[n / 2]);
+		boost::any comparison_values[] = {sorted_data[n / 2], sorted_data.front(), sorted_data.back(), std::make_pair(sorted_data[n / 4], sorted_data[3 * n / 4]), in_values};
+		ValueComparator comparators[] = {EQUAL, LESSER, LESSER_EQUAL, GREATER, GREATER_EQUAL, BETWEEN, IN};
+
+		boost::shared_ptr<ColumnBaseTyped<T> > compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		compressed_col->clearContent();
+		boost::shared_ptr<ColumnBaseTyped<T> > plain_col (new Column<T>("plain column", col->getType()));
+		boost::shared_ptr<ColumnBaseTyped<T> > columns[] = {compressed_col, plain_col};
+		for (unsigned int c = 0; c < 2; c++) {
+			std::vector<T> column_values(values.begin(), values.begin() + n / 2);
+			for (unsigned int i = 0; i < n / 2; i++) {
+				columns[c]->insert(values[i]);
+			}
+			//the index is built in bulk by the first lookup and maintained by the following inserts
+			columns[c]->createSortedIndex();
+			if (!columns[c]->index_scan(sorted_data.front(), EQUAL) || columns[c]->index_scan(sorted_data.front(), NOT_EQUAL)) {
+				std::cerr << "SORTED INDEX TEST FAILED! Lookup in column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+			for (unsigned int i = n / 2; i < n; i++) {
+				columns[c]->insert(values[i]);
+				column_values.push_back(values[i]);
+			}
+			for (unsigned int step = 0; step < 2; step++) {
+				for (unsigned int v = 0; v < 5; v++) {
+					for (unsigned int p = 0; p < 7; p++) {
+						if ((v == 3) != (comparators[p] == BETWEEN) || (v == 4) != (comparators[p] == IN)) continue;
+						ValuePredicate<T> predicate(comparison_values[v], comparators[p]);
+						PositionList expected_tids;
+						for (unsigned int i = 0; i < column_values.size(); i++) {
+							if (predicate(column_values[i])) expected_tids.push_back(i);
+						}
+						PositionListPtr index_tids = columns[c]->index_scan(comparison_values[v], comparators[p]);
+						if (!index_tids || *index_tids != expected_tids || *columns[c]->selection(comparison_values[v], comparators[p]) != expected_tids) {
+							std::cerr << "SORTED INDEX TEST FAILED! Column: " << columns[c]->getName() << " Comparator: " << comparators[p] << " Step: " << step << std::endl;
+							return false;
+						}
+					}
+				}
+				if (step == 0) {
+					columns[c]->update(TID(3), boost::any(sorted_data.back()));
+					column_values[3] = sorted_data.back();
+					columns[c]->update(TID(n / 2), boost::any(sorted_data.front()));
+					column_values[n / 2] = sorted_data.front();
+					columns[c]->remove(TID(7));
+					column_values.erase(column_values.begin() + 7);
+				}
+			}
+			columns[c]->dropSortedIndex();
+			if (columns[c]->hasSortedIndex() || columns[c]->index_scan(sorted_data.front(), EQUAL)) {
+				std::cerr << "SORTED INDEX TEST FAILED! Drop index of column: " << columns[c]->getName() << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** HASH INDEX TEST ******/
+	{
+		std::cout << "HASH INDEX TEST: look up rows and join with a hash index..."; // << std::endl;
+
+		boost::shared_ptr<ColumnBaseTyped<T> > dimension_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		dimension_col->clearContent();
+		boost::shared_ptr<ColumnBaseTyped<T> > fact_col (new Column<T>("fact column", col->getType()));
+		std::vector<T> dimension_values(reference_data);
+		std::vector<T> fact_values;
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			dimension_col->insert(reference_data[i]);
+		}
+		for (unsigned int i = 0; i < 20; i++) {
+			for (unsigned int j = 0; j < reference_data.size(); j++) {
+				fact_values.push_back(reference_data[(j * 7 + i) % reference_data.size()]);
+				fact_col->insert(fact_values.back());
+			}
+		}
+		dimension_col->createHashIndex();
+		std::vector<T> in_values;
+		in_values.push_back(reference_data[1]);
+		in_values.push_back(reference_data[2]);
+
+		for (unsigned int step = 0; step < 3; step++) {
+			PositionList expected_tids;
+			PositionList expected_in_tids;
+			for (unsigned int i = 0; i < dimension_values.size(); i++) {
+				if (dimension_values[i] == reference_data[0]) expected_tids.push_back(i);
+				if (dimension_values[i] == in_values[0] || dimension_values[i] == in_values[1]) expected_in_tids.push_back(i);
+			}
+			std::vector<TID_Pair> expected_join_tids;
+			for (unsigned int i = 0; i < dimension_values.size(); i++) {
+				for (unsigned int j = 0; j < fact_values.size(); j++) {
+					if (dimension_values[i] == fact_values[j]) expected_join_tids.push_back(TID_Pair(i, j));
+				}
+			}
+			std::sort(expected_join_tids.begin(), expected_join_tids.end());
+			if (*dimension_col->selection(reference_data[0], EQUAL) != expected_tids || *dimension_col->selection(in_values, IN) != expected_in_tids) {
+				std::cerr << "HASH INDEX TEST FAILED! Selection Step: " << step << std::endl;
+				return false;
+			}
+			//the dimension column is the build side of all four joins
+			BitmapPtr fact_filter (new Bitmap(fact_values.size(), true));
+			PositionListPairPtr join_results[] = {dimension_col->hash_join(fact_col), dimension_col->join(fact_col, HASH_JOIN), fact_col->join(dimension_col, AUTO_JOIN),
+			                                      dimension_col->hash_join(fact_col, BitmapPtr(), fact_filter)};
+			for (unsigned int r = 0; r < 4; r++) {
+				const PositionList& dimension_tids = (r != 2) ? *join_results[r]->first : *join_results[r]->second;
+				const PositionList& fact_tids = (r != 2) ? *join_results[r]->second : *join_results[r]->first;
+				std::vector<TID_Pair> join_tids;
+				for (unsigned int i = 0; i < dimension_tids.size() && i < fact_tids.size(); i++) {
+					join_tids.push_back(TID_Pair(dimension_tids[i], fact_tids[i]));
+				}
+				std::sort(join_tids.begin(), join_tids.end());
+				if (dimension_tids.size() != fact_tids.size() || join_tids != expected_join_tids) {
+					std::cerr << "HASH INDEX TEST FAILED! Join: " << r << " Step: " << step << std::endl;
+					return false;
+				}
+			}
+			if (step == 0) {
+				//maintained in place
+				dimension_col->insert(reference_data[0]);
+				dimension_values.push_back(reference_data[0]);
+				dimension_col->update(TID(5), boost::any(reference_data[1]));
+				dimension_values[5] = reference_data[1];
+			} else if (step == 1) {
+				//rebuilt by the next lookup
+				dimension_col->remove(TID(3));
+				dimension_values.erase(dimension_values.begin() + 3);
+			}
+		}
+		dimension_col->dropHashIndex();
+		if (dimension_col->hasHashIndex()) {
+			std::cerr << "HASH INDEX TEST FAILED! Drop index" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** COLUMN IMPRINTS TEST ******/
+	{
+		std::cout << "COLUMN IMPRINTS TEST: skip cache lines of an unclustered plain column that cannot match..."; // << std::endl;
+
+		std::vector<T> sorted_data(reference_data);
+		std::sort(sorted_data.begin(), sorted_data.end());
+		const size_t n = sorted_data.size();
+		//runs of 16 equal values in scattered order, so that no segment can be skipped, but whole cache lines match or can be skipped
+		std::vector<T> values;
+		boost::shared_ptr<Column<T> > plain_col (new Column<T>("plain column", col->getType()));
+		for (size_t i = 0; i < 2 * ZONE_MAP_SEGMENT_SIZE + 100; i++) {
+			values.push_back(sorted_data[((i / 16) * 7919) % n]);
+			plain_col->insert(values.back());
+		}
+		std::vector<T> in_values;
+		in_values.push_back(sorted_data[n / 3]);
+		in_values.push_back(sorted_data[n / 2]);
+		boost::any comparison_values[] = {sorted_data[n / 2], sorted_data[n / 4], sorted_data[3 * n / 4], std::make_pair(sorted_data[n / 4], sorted_data[n / 2]), in_values};
+		ValueComparator comparators[] = {EQUAL, LESSER, LESSER_EQUAL, GREATER, GREATER_EQUAL, BETWEEN, IN};
+
+		for (unsigned int step = 0; step < 4; step++) {
+			for (unsigned int v = 0; v < 5; v++) {
+				for (unsigned int p = 0; p < 7; p++) {
+					if ((v == 3) != (comparators[p] == BETWEEN) || (v == 4) != (comparators[p] == IN)) continue;
+					ValuePredicate<T> predicate(comparison_values[v], comparators[p]);
+					PositionList expected_tids;
+					for (unsigned int i = 0; i < values.size(); i++) {
+						if (predicate(values[i])) expected_tids.push_back(i);
+					}
+					if (*plain_col->selection(comparison_values[v], comparators[p]) != expected_tids) {
+						std::cerr << "COLUMN IMPRINTS TEST FAILED! Comparator: " << comparators[p] << " Step: " << step << std::endl;
+						return false;
+					}
+				}
+			}
+			if (step == 0) {
+				//adds a bin to the imprint of the first cache line
+				values[5] = sorted_data.back();
+				plain_col->update(TID(5), boost::any(values[5]));
+			} else if (step == 1) {
+				//starts a new cache line
+				values.push_back(sorted_data.front());
+				plain_col->insert(values.back());
+			} else if (step == 2) {
+				//moves rows to other cache lines
+				values.erase(values.begin());
+				plain_col->remove(TID(0));
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** PIPELINE TEST ******/
+	{
+		std::cout << "PIPELINE TEST: push batches through selections, joins and aggregations..."; // << std::endl;
+
+		//the fact table spans several batches, the dimension column is probed with a JoinHashTable and the small column with its HashIndex
+		boost::shared_ptr<ColumnBaseTyped<T> > fact_col (new Column<T>("fact column", col->getType()));
+		boost::shared_ptr<ColumnBaseTyped<T> > dimension_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		dimension_col->clearContent();
+		boost::shared_ptr<ColumnBaseTyped<T> > small_col (new Column<T>("small column", col->getType()));
+		std::vector<T> fact_values;
+		for (unsigned int i = 0; i < 100; i++) {
+			for (unsigned int j = 0; j < reference_data.size(); j++) {
+				fact_values.push_back(reference_data[(j * 7 + i) % reference_data.size()]);
+				fact_col->insert(fact_values.back());
+			}
+		}
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			dimension_col->insert(reference_data[i]);
+		}
+		for (unsigned int i = 0; i < 10; i++) {
+			small_col->insert(reference_data[i]);
+		}
+		small_col->createHashIndex();
+
+		Pipeline pipelines[] = {Pipeline(fact_col->size()), Pipeline(fact_col->size())};
+		for (unsigned int p = 0; p < 2; p++) {
+			if (!pipelines[p].addSelection(0, fact_col, reference_data[3], GREATER_EQUAL)
+			    || !pipelines[p].addJoin(0, fact_col, dimension_col)
+			    || !pipelines[p].addSelection(1, dimension_col, reference_data[7], NOT_EQUAL)
+			    || !pipelines[p].addJoin(1, dimension_col, small_col)) {
+				std::cerr << "PIPELINE TEST FAILED! Create pipeline" << std::endl;
+				return false;
+			}
+		}
+		pipelines[1].addAggregation(0, fact_col, SUM);
+		pipelines[1].addAggregation(1, dimension_col, MIN);
+		pipelines[1].addAggregation(2, small_col, COUNT);
+		pipelines[0].execute();
+		pipelines[1].execute();
+
+		std::vector<std::vector<TID> > expected_rows;
+		for (unsigned int f = 0; f < fact_values.size(); f++) {
+			if (fact_values[f] < reference_data[3]) continue;
+			for (unsigned int d = 0; d < reference_data.size(); d++) {
+				if (reference_data[d] != fact_values[f] || reference_data[d] == reference_data[7]) continue;
+				for (unsigned int s = 0; s < 10; s++) {
+					if (reference_data[s] != reference_data[d]) continue;
+					std::vector<TID> row;
+					row.push_back(f);
+					row.push_back(d);
+					row.push_back(s);
+					expected_rows.push_back(row);
+				}
+			}
+		}
+		std::vector<std::vector<TID> > rows;
+		for (unsigned int i = 0; pipelines[0].getResult(0) && i < pipelines[0].getResult(0)->size(); i++) {
+			std::vector<TID> row;
+			for (unsigned int t = 0; t < pipelines[0].getNumberOfTables(); t++) {
+				row.push_back((*pipelines[0].getResult(t))[i]);
+			}
+			rows.push_back(row);
+		}
+		std::sort(rows.begin(), rows.end());
+		if (rows != expected_rows || pipelines[1].getResult(0)) {
+			std::cerr << "PIPELINE TEST FAILED! Result rows" << std::endl;
+			return false;
+		}
+		if (!equal_aggregates<T>(pipelines[1].getAggregate(0), fact_col->aggregate(SUM, pipelines[0].getResult(0)))
+		    || !equal_aggregates<T>(pipelines[1].getAggregate(1), dimension_col->aggregate(MIN, pipelines[0].getResult(1)))
+		    || !equal_aggregates<T>(pipelines[1].getAggregate(2), boost::any(expected_rows.size()))) {
+			std::cerr << "PIPELINE TEST FAILED! Aggregates" << std::endl;
+			return false;
+		}
+		Operation operations[] = {FULL_SCAN, SELECTION, JOIN, SELECTION, JOIN, AGGREGATION, AGGREGATION, AGGREGATION};
+		if (pipelines[1].getOperations() != std::vector<Operation>(operations, operations + 8)) {
+			std::cerr << "PIPELINE TEST FAILED! Operations" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** TASK SCHEDULER TEST ******/
+	{
+		std::cout << "TASK SCHEDULER TEST: process morsels of nested jobs, sort and scan large columns in parallel..."; // << std::endl;
+
+		//each row has to be processed exactly once and each thread has to keep a participant number below the limit
+		const size_t number_of_rows = 1000 * 1000 + 7;
+		const size_t morsel_size = 1000;
+		const unsigned int maximal_participants = 4;
+		std::vector<unsigned char> processed(number_of_rows, 0);
+		std::atomic<size_t> processed_rows(0);
+		std::atomic<bool> valid_morsels(true);
+		TaskScheduler::getInstance().execute(number_of_rows, morsel_size, maximal_participants,
+			[&processed, &processed_rows, &valid_morsels, number_of_rows, morsel_size, maximal_participants](unsigned int participant, size_t begin, size_t end) {
+				if (participant >= maximal_participants || begin % morsel_size != 0 || end > number_of_rows || (end - begin != morsel_size && end != number_of_rows)) valid_morsels = false;
+				for (size_t i = begin; i < end; i++) processed[i] = 1;
+				processed_rows += end - begin;
+			});
+		if (!valid_morsels || processed_rows != number_of_rows || std::count(processed.begin(), processed.end(), 1) != std::ptrdiff_t(number_of_rows)) {
+			std::cerr << "TASK SCHEDULER TEST FAILED! Morsels" << std::endl;
+			return false;
+		}
+		//a morsel that submits a job takes part in it, so the nested jobs finish even if all workers wait for them
+		std::atomic<size_t> nested_rows(0);
+		parallel_for_chunks(16, 16, [&nested_rows](unsigned int, size_t begin, size_t end) {
+			for (size_t job = begin; job < end; job++) {
+				parallel_for_chunks(100 * 1000, 16, [&nested_rows](unsigned int, size_t first_row, size_t last_row) {
+					nested_rows += last_row - first_row;
+				}, 1000);
+			}
+		}, 1);
+		if (nested_rows != 16 * 100 * 1000) {
+			std::cerr << "TASK SCHEDULER TEST FAILED! Nested jobs" << std::endl;
+			return false;
+		}
+
+		//the sort has to be stable, so equal values keep the order of their TIDs
+		boost::shared_ptr<Column<T> > large_col (new Column<T>("large column", col->getType()));
+		std::vector<std::pair<T, TID> > expected_pairs;
+		for (unsigned int i = 0; i < 300 * 1000; i++) {
+			const T value = reference_data[(i * 7919) % reference_data.size()];
+			large_col->insert(value);
+			expected_pairs.push_back(std::make_pair(value, TID(i)));
+		}
+		SortOrder orders[] = {ASCENDING, DESCENDING};
+		for (unsigned int o = 0; o < 2; o++) {
+			std::vector<std::pair<T, TID> > sorted_pairs(expected_pairs);
+			if (orders[o] == ASCENDING) {
+				std::stable_sort(sorted_pairs.begin(), sorted_pairs.end(), [](const std::pair<T, TID>& a, const std::pair<T, TID>& b) { return a.first < b.first; });
+			} else {
+				std::stable_sort(sorted_pairs.begin(), sorted_pairs.end(), [](const std::pair<T, TID>& a, const std::pair<T, TID>& b) { return b.first < a.first; });
+			}
+			PositionList expected_tids;
+			for (unsigned int i = 0; i < sorted_pairs.size(); i++) expected_tids.push_back(sorted_pairs[i].second);
+			if (*large_col->sort(orders[o]) != expected_tids) {
+				std::cerr << "TASK SCHEDULER TEST FAILED! Sort order: " << orders[o] << std::endl;
+				return false;
+			}
+		}
+		//the TIDs of the morsels have to be concatenated in TID order
+		PositionList expected_tids;
+		for (unsigned int i = 0; i < expected_pairs.size(); i++) {
+			if (expected_pairs[i].first < reference_data[50]) expected_tids.push_back(i);
+		}
+		if (*large_col->selection(reference_data[50], LESSER) != expected_tids) {
+			std::cerr << "TASK SCHEDULER TEST FAILED! Selection" << std::endl;
+			return false;
+		}
+		//the per-thread arrays of the compressed column are merged, even if a thread did not process a morsel
+		boost::shared_ptr<ColumnBaseTyped<T> > large_compressed_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		large_compressed_col->clearContent();
+		boost::shared_ptr<Column<T> > group_value_col (new Column<T>("group value column", col->getType()));
+		std::vector<T> large_values;
+		std::map<T, std::pair<size_t, T> > reference_groups;
+		for (unsigned int i = 0; i < expected_pairs.size(); i++) {
+			large_values.push_back(expected_pairs[i].first);
+			large_compressed_col->insert(expected_pairs[i].first);
+			const T group_value = reference_data[(i * 31) % reference_data.size()];
+			group_value_col->insert(group_value);
+			std::pair<size_t, T>& group = reference_groups.insert(std::make_pair(expected_pairs[i].first, std::make_pair(size_t(0), group_value))).first->second;
+			group.first++;
+			if (group.second < group_value) group.second = group_value;
+		}
+		for (unsigned int run = 0; run < 10; run++) {
+			if (!equal_aggregates<T>(large_compressed_col->aggregate(COUNT), reference_aggregate(large_values, COUNT))
+			    || !equal_aggregates<T>(large_compressed_col->aggregate(SUM), reference_aggregate(large_values, SUM))) {
+				std::cerr << "TASK SCHEDULER TEST FAILED! Aggregation of compressed column" << std::endl;
+				return false;
+			}
+			ColumnPairPtr count_result = group_value_col->aggregate_by_keys(large_compressed_col, COUNT);
+			ColumnPairPtr max_result = group_value_col->aggregate_by_keys(large_compressed_col, MAX);
+			if (!count_result || !max_result || count_result->first->size() != reference_groups.size() || max_result->first->size() != reference_groups.size()) {
+				std::cerr << "TASK SCHEDULER TEST FAILED! Number of groups of compressed keys" << std::endl;
+				return false;
+			}
+			for (TID i = 0; i < reference_groups.size(); i++) {
+				if (boost::any_cast<int>(count_result->second->get(i)) != int(reference_groups[boost::any_cast<T>(count_result->first->get(i))].first)
+				    || boost::any_cast<T>(max_result->second->get(i)) != reference_groups[boost::any_cast<T>(max_result->first->get(i))].second) {
+					std::cerr << "TASK SCHEDULER TEST FAILED! Group by compressed keys" << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
 	/****** STORE AND LOAD TEST ******/
 	{
 		std::cout << "STORE AND LOAD TEST: store column data on disc and load it..."; // << std::endl;
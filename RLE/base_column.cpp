@@ -1,13 +1,14 @@
 
 #include <core/base_column.hpp>
 #include <core/column.hpp>
+#include <core/bitmap.hpp>
 #include <iostream>
 
 using namespace std;
 
 namespace CoGaDB{
 
-	ColumnBase::ColumnBase(const std::string& name, AttributeType db_type) : name_(name), db_type_(db_type){
+	ColumnBase::ColumnBase(const std::string& name, AttributeType db_type) : name_(name), db_type_(db_type), observed_selectivity_(0){
 
 	}
 
@@ -21,6 +22,24 @@ namespace CoGaDB{
 		return name_;
 	}
 
+	const SelectionResult ColumnBase::adaptive_selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		//weight of the last selection in the observed selectivity
+		const double STATISTICS_WEIGHT = 0.3;
+		//a TID costs sizeof(TID)*8 bits in a PositionList, a row costs one bit in a Bitmap
+		const double BREAK_EVEN_SELECTIVITY = 1.0/(sizeof(TID)*8);
+		size_t number_of_rows = this->size();
+		if(number_of_rows==0) return SelectionResult(PositionListPtr(new PositionList()),0);
+
+		if(observed_selectivity_>BREAK_EVEN_SELECTIVITY){
+			BitmapPtr bitmap = this->bitmap_selection(value_for_comparison,comp);
+			observed_selectivity_ = (1-STATISTICS_WEIGHT)*observed_selectivity_ + STATISTICS_WEIGHT*(double(bitmap->count())/number_of_rows);
+			return SelectionResult(bitmap);
+		}
+		PositionListPtr tids = this->selection(value_for_comparison,comp);
+		observed_selectivity_ = (1-STATISTICS_WEIGHT)*observed_selectivity_ + STATISTICS_WEIGHT*(double(tids->size())/number_of_rows);
+		return SelectionResult(tids,number_of_rows);
+	}
+
 	const ColumnPtr createColumn(AttributeType type, const std::string& name){
 
 	ColumnPtr ptr;
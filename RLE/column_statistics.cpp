@@ -0,0 +1,53 @@
+
+#include <core/column_statistics.hpp>
+#include <cmath>
+
+namespace CoGaDB{
+
+	HyperLogLog::HyperLogLog() : registers_(size_t(1) << HYPERLOGLOG_PRECISION,0){
+
+	}
+
+	double HyperLogLog::estimate() const{
+		const double number_of_registers = registers_.size();
+		double sum=0;
+		size_t number_of_empty_registers=0;
+		for(size_t i=0;i<registers_.size();++i){
+			sum+=std::ldexp(1.0,-registers_[i]);
+			if(registers_[i]==0) number_of_empty_registers++;
+		}
+		const double alpha = 0.7213/(1.0+1.079/number_of_registers);
+		double estimate = alpha*number_of_registers*number_of_registers/sum;
+		//linear counting is more accurate for small cardinalities
+		if(estimate<=2.5*number_of_registers && number_of_empty_registers>0){
+			estimate = number_of_registers*std::log(number_of_registers/number_of_empty_registers);
+		}
+		return estimate;
+	}
+
+	void HyperLogLog::clear(){
+		std::fill(registers_.begin(),registers_.end(),0);
+	}
+
+	ColumnStatistics::ColumnStatistics() : number_of_rows_(0), sorted_ascending_(true), sorted_descending_(true), valid_(true), number_of_changes_(0), number_of_rows_at_rebuild_(0), distinct_values_(){
+
+	}
+
+	ColumnStatistics::~ColumnStatistics(){
+
+	}
+
+	double ColumnStatistics::getNumberOfDistinctValues() const{
+		if(number_of_rows_==0) return 0;
+		double estimate = distinct_values_.estimate();
+		if(estimate<1) return 1;
+		if(estimate>number_of_rows_) return number_of_rows_;
+		return estimate;
+	}
+
+	bool ColumnStatistics::needsRebuild() const throw(){
+		return !valid_ || number_of_changes_>STATISTICS_REBUILD_FRACTION*number_of_rows_at_rebuild_;
+	}
+
+}; //end namespace CogaDB
+
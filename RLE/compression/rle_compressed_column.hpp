@@ -6,6 +6,7 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <core/column.hpp>
 using namespace std;
 
 namespace CoGaDB{
@@ -41,17 +42,81 @@ class RleCompressedColumn : public CompressedColumn<T>{
 	virtual unsigned int getSizeinBytes() const throw();
 
 	virtual const ColumnPtr copy() const;
+	/*! \brief decodes the requested rows in a single forward pass over the runs, unsorted TIDs are sorted first*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	/*! \brief appends the value of each run as often as bits are set in the run*/
+	virtual const ColumnPtr gather(BitmapPtr tids);
 
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 
-
+	/*! \brief computes the top k on the runs, a run that cannot improve the top k is skipped as a whole*/
+	virtual const PositionListPtr topk(unsigned int k, SortOrder order);
+	/*! \brief evaluates the predicate once per run and emits the TIDs of all matching runs*/
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp);
 	
 	virtual T& operator[](const int index);
 	
 	/*! values*/
 	std::vector<T> rle_vector;
 	std::vector<int> rle_count;
+
+	protected:
+	/*! \brief returns the value of each run*/
+	virtual void getDistinctValues(std::vector<T>& values);
+	/*! \brief applies the operation to the value of each run only, so it costs O(runs) instead of O(rows)*/
+	virtual bool applyConstantOperation(ColumnAlgebraOperation op, const T& value);
+	/*! \brief aggregation operations add the value of each run once, weighted by the number of selected rows in the run*/
+	virtual void aggregateAll(AggregationState<T>& state);
+	/*! \brief sorts a copy of the TIDs and follows them with a run cursor*/
+	virtual void aggregatePositions(const PositionList& tids, AggregationState<T>& state);
+	virtual void aggregateBitmap(const Bitmap& tids, AggregationState<T>& state);
+};
+
+/*! \brief ColumnFilter on runs, the predicate is evaluated once per run and a run cursor follows ascending TIDs*/
+class RunFilter : public ColumnFilter{
+	public:
+	RunFilter(const std::vector<int>& run_lengths, const std::vector<char>& run_matches) 
+		: run_lengths_(run_lengths), run_matches_(run_matches), run_(0), run_begin_(0){}
+
+	virtual size_t filter(TID begin, TID end, TID* result){
+		size_t number_of_matches=0;
+		for(TID i=begin;i<end;i++){
+			result[number_of_matches]=i;
+			number_of_matches+=matches(i);
+		}
+		return number_of_matches;
+	}
+
+	virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result){
+		size_t number_of_matches=0;
+		for(size_t i=0;i<number_of_candidates;i++){
+			TID tid=candidates[i];
+			result[number_of_matches]=tid;
+			number_of_matches+=matches(tid);
+		}
+		return number_of_matches;
+	}
+
+	private:
+	/*! \brief moves the run cursor to the run containing tid and returns whether that run matches*/
+	inline char matches(TID tid){
+		if(tid<run_begin_){
+			run_=0;
+			run_begin_=0;
+		}
+		while(run_begin_+run_lengths_[run_]<=tid){
+			run_begin_+=run_lengths_[run_];
+			run_++;
+		}
+		return run_matches_[run_];
+	}
+
+	const std::vector<int>& run_lengths_;
+	std::vector<char> run_matches_;
+	size_t run_;
+	TID run_begin_;
 };
 
 
@@ -92,7 +157,8 @@ class RleCompressedColumn : public CompressedColumn<T>{
 			rle_count.push_back(1);
 			rle_vector.push_back(new_value);
 		}
-	
+		this->statistics_.insert(new_value);
+		this->indexInsert(new_value);
 		return true;
 	}
 
@@ -154,6 +220,49 @@ class RleCompressedColumn : public CompressedColumn<T>{
 		return ColumnPtr(new RleCompressedColumn<T>(*this));
 	}
 
+	template<class T>
+	void RleCompressedColumn<T>::getDistinctValues(std::vector<T>& values){
+		values.insert(values.end(),rle_vector.begin(),rle_vector.end());
+	}
+
+	template<class T>
+	const ColumnPtr RleCompressedColumn<T>::gather(PositionListPtr tids){
+		if(!tids || !is_valid_position_list(*tids,this->size())) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.resize(tids->size());
+		const bool sorted = is_sorted_position_list(*tids);
+		std::vector<std::pair<TID,TID> > positions;
+		if(!sorted) positions = sort_positions(*tids);
+
+		size_t run=0;
+		TID run_end=rle_vector.empty() ? 0 : rle_count[0];
+		for(size_t i=0;i<tids->size();i++){
+			TID tid = sorted ? (*tids)[i] : positions[i].first;
+			while(tid>=run_end){
+				run++;
+				run_end+=rle_count[run];
+			}
+			result_values[sorted ? i : positions[i].second]=rle_vector[run];
+		}
+		return result;
+	}
+
+	template<class T>
+	const ColumnPtr RleCompressedColumn<T>::gather(BitmapPtr tids){
+		if(!tids || tids->size()!=this->size()) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.reserve(tids->count());
+		TID run_begin=0;
+		for(size_t run=0;run<rle_vector.size();run++){
+			TID run_end=run_begin+rle_count[run];
+			result_values.insert(result_values.end(),tids->count(run_begin,run_end),rle_vector[run]);
+			run_begin=run_end;
+		}
+		return result;
+	}
+
 	template<class T>
 	bool RleCompressedColumn<T>::update(TID tid, const boost::any& new_value){
 		if(new_value.empty()) return false;
@@ -285,7 +394,8 @@ class RleCompressedColumn : public CompressedColumn<T>{
 	
 		rle_vector.clear();
 		rle_count.clear();
-		
+		this->statistics_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -337,11 +447,102 @@ class RleCompressedColumn : public CompressedColumn<T>{
 		boost::archive::binary_iarchive ia2(infile2);
 		ia2 >> rle_count;
 		infile2.close();
-
+		this->statistics_.invalidate();
+		this->invalidateIndex();
 
 		return true;
 	}
 
+	template<class T>
+	const PositionListPtr RleCompressedColumn<T>::topk(unsigned int k, SortOrder order){
+		if(k>=this->size()) return this->sort(order);
+
+		TopKHeap<T> heap(k,order);
+		TID run_begin = 0;
+		for(unsigned i = 0; i < rle_vector.size(); i++){
+			//the TIDs of a run ascend, so if the first TID is rejected, the remaining TIDs are rejected as well
+			for(int j = 0; j < rle_count[i] && heap.accepts(rle_vector[i],run_begin+j); j++){
+				heap.push(rle_vector[i],run_begin+j);
+			}
+			run_begin += rle_count[i];
+		}
+		return heap.getTIDs();
+	}
+
+	template<class T>
+	const PositionListPtr RleCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		PositionListPtr index_tids = this->indexSelection(predicate);
+		if(index_tids) return index_tids;
+
+		PositionListPtr result_tids( new PositionList());
+		TID run_begin = 0;
+		for(unsigned i = 0; i < rle_vector.size(); i++){
+			if(predicate(rle_vector[i])){
+				for(int j = 0; j < rle_count[i]; j++){
+					result_tids->push_back(run_begin+j);
+				}
+			}
+			run_begin += rle_count[i];
+		}
+		return result_tids;
+	}
+
+	template<class T>
+	const ColumnFilterPtr RleCompressedColumn<T>::createFilter(const boost::any& value_for_comparison, const ValueComparator comp){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		std::vector<char> run_matches(rle_vector.size());
+		for(unsigned i = 0; i < rle_vector.size(); i++){
+			run_matches[i]=predicate(rle_vector[i]);
+		}
+		return ColumnFilterPtr(new RunFilter(rle_count,run_matches));
+	}
+
+	template<class T>
+	bool RleCompressedColumn<T>::applyConstantOperation(ColumnAlgebraOperation op, const T& value){
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		return apply_constant_operation(rle_vector.data(),rle_vector.size(),op,value);
+	}
+
+	template<class T>
+	void RleCompressedColumn<T>::aggregateAll(AggregationState<T>& state){
+		for(size_t run=0;run<rle_vector.size();run++){
+			state.add(rle_vector[run],rle_count[run]);
+		}
+	}
+
+	template<class T>
+	void RleCompressedColumn<T>::aggregatePositions(const PositionList& tids, AggregationState<T>& state){
+		PositionList sorted_tids(tids);
+		std::sort(sorted_tids.begin(),sorted_tids.end());
+		size_t run=0;
+		TID run_end=rle_vector.empty() ? 0 : rle_count[0];
+		size_t i=0;
+		while(i<sorted_tids.size()){
+			while(sorted_tids[i]>=run_end){
+				run++;
+				run_end+=rle_count[run];
+			}
+			size_t number_of_rows_in_run=0;
+			while(i<sorted_tids.size() && sorted_tids[i]<run_end){
+				number_of_rows_in_run++;
+				i++;
+			}
+			state.add(rle_vector[run],number_of_rows_in_run);
+		}
+	}
+
+	template<class T>
+	void RleCompressedColumn<T>::aggregateBitmap(const Bitmap& tids, AggregationState<T>& state){
+		TID run_begin=0;
+		for(size_t run=0;run<rle_vector.size();run++){
+			TID run_end=run_begin+rle_count[run];
+			state.add(rle_vector[run],tids.count(run_begin,run_end));
+			run_begin=run_end;
+		}
+	}
+
 	template<class T>
 	T& RleCompressedColumn<T>::operator[](const int index){
 		int size = 0;
@@ -0,0 +1,114 @@
+
+#include <core/conjunctive_scan.hpp>
+#include <core/column_statistics.hpp>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+namespace CoGaDB{
+
+	/*! \brief weight of the statistics of the newest batch in the moving averages*/
+	const double STATISTICS_WEIGHT = 0.3;
+
+	ConjunctiveScan::ConjunctiveScan() : columns_(), filters_(), statistics_(), order_(){
+
+	}
+
+	bool ConjunctiveScan::addPredicate(ColumnPtr column, const boost::any& value_for_comparison, const ValueComparator comp){
+		if(!column) return false;
+		if(!columns_.empty() && columns_.front()->size()!=column->size()){
+			cout << "Error! ConjunctiveScan: column " << column->getName() << " has " << column->size() 
+			     << " rows, but column " << columns_.front()->getName() << " has " << columns_.front()->size() << " rows" << endl;
+			return false;
+		}
+		columns_.push_back(column);
+		filters_.push_back(column->createFilter(value_for_comparison,comp));
+		statistics_.push_back(PredicateStatistics());
+		statistics_.back().selectivity = column->getColumnStatistics().estimateSelectivity(value_for_comparison,comp);
+		order_.push_back(order_.size());
+		return true;
+	}
+
+	const std::vector<unsigned int>& ConjunctiveScan::getPredicateOrder() const throw(){
+		return order_;
+	}
+
+	const PositionListPtr ConjunctiveScan::execute(){
+		PositionListPtr result_tids( new PositionList());
+		if(columns_.empty()) return result_tids;
+
+		//the first condition of each batch is always measured, so no condition was measured if the first one was not
+		if(!statistics_[order_.front()].measured) orderByEstimatedSelectivity();
+
+		const size_t number_of_rows = columns_.front()->size();
+		std::vector<TID> selection_vector(CONJUNCTIVE_SCAN_BATCH_SIZE);
+		for(size_t begin=0;begin<number_of_rows;begin+=CONJUNCTIVE_SCAN_BATCH_SIZE){
+			const size_t end = std::min(begin+CONJUNCTIVE_SCAN_BATCH_SIZE,number_of_rows);
+			size_t number_of_candidates = end-begin;
+			for(unsigned int i=0;i<order_.size() && number_of_candidates>0;i++){
+				const unsigned int predicate = order_[i];
+				const size_t rows_in = number_of_candidates;
+
+				chrono::steady_clock::time_point start = chrono::steady_clock::now();
+				if(i==0){
+					number_of_candidates = filters_[predicate]->filter(begin,end,&selection_vector[0]);
+				}else{
+					number_of_candidates = filters_[predicate]->filter(&selection_vector[0],number_of_candidates,&selection_vector[0]);
+				}
+				double seconds = chrono::duration<double>(chrono::steady_clock::now()-start).count();
+
+				PredicateStatistics& statistics = statistics_[predicate];
+				double selectivity = double(number_of_candidates)/rows_in;
+				double cost_per_row = seconds/rows_in;
+				if(statistics.measured){
+					statistics.selectivity = (1-STATISTICS_WEIGHT)*statistics.selectivity+STATISTICS_WEIGHT*selectivity;
+					statistics.cost_per_row = (1-STATISTICS_WEIGHT)*statistics.cost_per_row+STATISTICS_WEIGHT*cost_per_row;
+				}else{
+					statistics.selectivity = selectivity;
+					statistics.cost_per_row = cost_per_row;
+					statistics.measured = true;
+				}
+			}
+			result_tids->insert(result_tids->end(),selection_vector.begin(),selection_vector.begin()+number_of_candidates);
+			reorderPredicates();
+		}
+		return result_tids;
+	}
+
+	namespace {
+		struct PredicateRankLesser{
+			explicit PredicateRankLesser(const std::vector<double>& ranks) : ranks_(ranks){}
+			bool operator()(unsigned int a, unsigned int b) const { return ranks_[a]<ranks_[b]; }
+			const std::vector<double>& ranks_;
+		};
+	}
+
+	void ConjunctiveScan::reorderPredicates(){
+		std::vector<double> ranks(statistics_.size());
+		for(unsigned int i=0;i<statistics_.size();i++){
+			const PredicateStatistics& statistics = statistics_[i];
+			if(!statistics.measured){
+				//conditions that were never reached keep their position behind the measured ones
+				ranks[i]=numeric_limits<double>::max();
+			}else if(statistics.selectivity>=1.0){
+				ranks[i]=numeric_limits<double>::max()/2;
+			}else{
+				ranks[i]=statistics.cost_per_row/(1.0-statistics.selectivity);
+			}
+		}
+		std::stable_sort(order_.begin(),order_.end(),PredicateRankLesser(ranks));
+	}
+
+	void ConjunctiveScan::orderByEstimatedSelectivity(){
+		std::vector<double> ranks(statistics_.size());
+		for(unsigned int i=0;i<statistics_.size();i++){
+			ranks[i]=statistics_[i].selectivity;
+		}
+		std::stable_sort(order_.begin(),order_.end(),PredicateRankLesser(ranks));
+	}
+
+}; //end namespace CogaDB
+
@@ -23,6 +23,46 @@ typedef std::pair<PositionListPtr,PositionListPtr> PositionListPair;
 typedef shared_pointer_namespace::shared_ptr<PositionListPair> PositionListPairPtr;
 
 class Table; //forward declaration
+class Bitmap; //forward declaration, defined in core/bitmap.hpp
+/* \brief a BitmapPtr is a references counted smart pointer to a Bitmap object*/
+typedef shared_pointer_namespace::shared_ptr<Bitmap> BitmapPtr;
+class SelectionResult; //forward declaration, defined in core/bitmap.hpp
+class ColumnStatistics; //forward declaration, defined in core/column_statistics.hpp
+
+/*!
+ *  \brief     A ColumnFilter is a filter condition bound to a column, which is evaluated on batches of rows.
+ *  \details   Filters are created by ColumnBase::createFilter. They are used by operators that evaluate several filter conditions
+ *             batch by batch on selection vectors (arrays of TIDs), e.g., the ConjunctiveScan. A filter may keep a cursor into its column,
+ *             so it is fastest when the TIDs of consecutive calls ascend, and it must not be shared between threads or outlive its column.
+ */
+class ColumnFilter{
+	public:
+	virtual ~ColumnFilter(){}
+	/*! \brief writes the TIDs in [begin,end) whose values match to result
+	 *  \return number of TIDs written to result*/
+	virtual size_t filter(TID begin, TID end, TID* result)=0;
+	/*! \brief writes the candidate TIDs whose values match to result, result may point to candidates
+	 *  \return number of TIDs written to result*/
+	virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result)=0;
+};
+/*! \brief a ColumnFilterPtr is a references counted smart pointer to a ColumnFilter object*/
+typedef shared_pointer_namespace::shared_ptr<ColumnFilter> ColumnFilterPtr;
+
+/*!
+ *  \brief     A ColumnProbe is the hash table of an equi-join on a build column, which is probed with batches of rows of a probe column.
+ *  \details   Probes are created by ColumnBase::createProbe on the build column. They are used by operators that push batches of rows
+ *             through a join without materializing the join result, e.g., the Pipeline. Like a ColumnFilter, a probe must not be shared
+ *             between threads or outlive its columns.
+ */
+class ColumnProbe{
+	public:
+	virtual ~ColumnProbe(){}
+	/*! \brief looks up the values of the probe column on the positions in candidates and appends for each pair of matching rows
+	 *  the index of the candidate to positions and the TID of the build column to build_tids, so positions is ascending*/
+	virtual void probe(const TID* candidates, size_t number_of_candidates, std::vector<TID>& positions, std::vector<TID>& build_tids)=0;
+};
+/*! \brief a ColumnProbePtr is a references counted smart pointer to a ColumnProbe object*/
+typedef shared_pointer_namespace::shared_ptr<ColumnProbe> ColumnProbePtr;
 
 /*!
  * 
@@ -39,6 +79,10 @@ class ColumnBase{
 	public:
 	/*! \brief defines a smart pointer to a ColumnBase Object*/
 	typedef shared_pointer_namespace::shared_ptr<ColumnBase> ColumnPtr;
+	/*! \brief defines a pair of smart pointers to ColumnBase Objects, e.g., the key and aggregate columns of a group by*/
+	typedef std::pair<ColumnPtr,ColumnPtr> ColumnPair;
+	/*! \brief defines a smart pointer to a ColumnPair*/
+	typedef shared_pointer_namespace::shared_ptr<ColumnPair> ColumnPairPtr;
 	/***************** constructors and destructor *****************/
 	ColumnBase(const std::string& name, AttributeType db_type);
 	virtual ~ColumnBase();
@@ -52,6 +96,9 @@ class ColumnBase{
 	/*! \brief updates the values specified by the position list with a value new_Value
 	 *  \return true for sucess and false in case an error occured*/	
 	virtual bool update(PositionListPtr tids, const boost::any& new_value) = 0;		
+	/*! \brief updates the values whose bits are set in the bitmap with a value new_Value
+	 *  \return true for sucess and false in case an error occured*/	
+	virtual bool update(BitmapPtr tids, const boost::any& new_value) = 0;		
 	/*! \brief deletes the value on position tid
 	 *  \return true for sucess and false in case an error occured*/
 	virtual bool remove(TID tid)=0;
@@ -59,6 +106,9 @@ class ColumnBase{
 	 *  \details assumes tid list is sorted ascending
 	 *  \return true for sucess and false in case an error occured*/		
 	virtual bool remove(PositionListPtr tid)=0;	
+	/*! \brief deletes the values whose bits are set in the bitmap
+	 *  \return true for sucess and false in case an error occured*/		
+	virtual bool remove(BitmapPtr tids)=0;	
 	/*! \brief deletes all values stored in the column
 	 *  \return true for sucess and false in case an error occured*/	
 	virtual bool clearContent()=0;
@@ -72,29 +122,95 @@ class ColumnBase{
 	virtual size_t size() const throw()=0;
 	/*! \brief returns the size in bytes the column consumes in main memory*/	
 	virtual unsigned int getSizeinBytes() const throw()=0;
+	/*! \brief returns the statistics of the column, which are maintained on insert, update and remove and rebuilt when outdated
+	 *  \details the reference is valid until the column is modified or destroyed*/	
+	virtual const ColumnStatistics& getColumnStatistics()=0;
 	/*! \brief virtual copy constructor
 	 * \return a ColumnPtr to an exakt copy of the current column*/	
 	virtual const ColumnPtr copy() const=0;
+	/*! \brief fetches the values on the positions in the position list into a new materialized column (late materialization)
+	 * \details the i-th row of the result is the value on position (*tids)[i], so the order of the position list is preserved
+	 * \return ColumnPtr to a materialized column, a NULL pointer in case a TID is out of range*/	
+	virtual const ColumnPtr gather(PositionListPtr tids)=0;
+	/*! \brief fetches the values whose bits are set in the bitmap into a new materialized column in TID order
+	 * \return ColumnPtr to a materialized column, a NULL pointer in case the bitmap does not have one bit per row*/	
+	virtual const ColumnPtr gather(BitmapPtr tids)=0;
 	/***************** relational operations on Columns which return a PositionListPtr/PositionListPairPtr *****************/
 	/*! \brief sorts a column w.r.t. a SortOrder
 	 * \return PositionListPtr to a PositionList, which represents the result*/		
 	virtual const PositionListPtr sort(SortOrder order=ASCENDING)= 0; 
-	/*! \brief filters the values of a column according to a filter condition consisting of a comparison value and a ValueComparator (=,<,>)
+	/*! \brief returns the TIDs of the first k values of a column w.r.t. a SortOrder, without sorting the whole column
+	 * \details equal values are ordered by their TID, so the result equals the first k TIDs returned by sort()
+	 * \return PositionListPtr to a PositionList, which represents the result*/		
+	virtual const PositionListPtr topk(unsigned int k, SortOrder order=ASCENDING)= 0; 
+	/*! \brief filters the values of a column according to a filter condition consisting of a comparison value and a ValueComparator (=,<,>,<=,>=,!=,BETWEEN,IN)
+	 * \details BETWEEN expects a std::pair<T,T> with inclusive bounds and IN a std::vector<T> as comparison value
 	 * \return PositionListPtr to a PositionList, which represents the result*/		
 	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp)= 0;
-	/*! \brief filters the values of a column in parallel according to a filter condition consisting of a comparison value and a ValueComparator (=,<,>)
+	/*! \brief filters the values of a column in parallel according to a filter condition consisting of a comparison value and a ValueComparator (=,<,>,<=,>=,!=,BETWEEN,IN)
 	 * \details the additional parameter specifies the number of threads that may be used to perform the operation
 	 * \return PositionListPtr to a PositionList, which represents the result*/		
 	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads) = 0;
+	/*! \brief creates a filter for the filter condition consisting of a comparison value and a ValueComparator, which can be evaluated on batches of TIDs
+	 * \return ColumnFilterPtr to a ColumnFilter for this column*/
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp) = 0;
+	/*! \brief filters the values of a column according to a filter condition consisting of a comparison value and a ValueComparator (=,<,>,<=,>=,!=,BETWEEN,IN)
+	 * \return BitmapPtr to a Bitmap with one bit per row, which represents the result*/		
+	virtual const BitmapPtr bitmap_selection(const boost::any& value_for_comparison, const ValueComparator comp)= 0;
+	/*! \brief filters the values of a column and returns the result either as PositionList or as Bitmap
+	 * \details the representation is chosen by the selectivity observed in the previous adaptive selections on this column: 
+	 * a Bitmap is smaller than a PositionList if more than one of sizeof(TID)*8 rows qualify
+	 * \return SelectionResult, which represents the result*/		
+	const SelectionResult adaptive_selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief joins two columns, AUTO_JOIN chooses the algorithm, the build side and the number of threads from the ColumnStatistics of both columns
+	 * \details the first PositionList of the result contains the TIDs of this column, the second the TIDs of join_column, the order of the pairs depends on the algorithm
+	 * \return PositionListPairPtr to a PositionListPair, which represents the result*/		
+	virtual const PositionListPairPtr join(ColumnPtr join_column, JoinAlgorithm algorithm=AUTO_JOIN)=0;
 	/*! \brief joins two columns using the hash join algorithm
 	 * \return PositionListPairPtr to a PositionListPair, which represents the result*/		
 	virtual const PositionListPairPtr hash_join(ColumnPtr join_column)=0;
+	/*! \brief joins the rows of this column whose bits are set in build_filter with the rows of join_column whose bits are set in probe_filter using the hash join algorithm
+	 * \details a NULL filter selects all rows, the result contains the TIDs of the unfiltered columns
+	 * \return PositionListPairPtr to a PositionListPair, which represents the result*/		
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column, BitmapPtr build_filter, BitmapPtr probe_filter)=0;
+	/*! \brief builds the hash table of an equi-join of probe_column with this column as build side, which can be probed with batches of TIDs of probe_column
+	 * \return ColumnProbePtr to a ColumnProbe for both columns, a NULL pointer in case the columns have different types*/		
+	virtual const ColumnProbePtr createProbe(ColumnPtr probe_column)=0;
+	/*! \brief creates a BloomFilter from the values of the rows whose bits are set in filter, a NULL filter selects all rows
+	 * \details the result can be passed as comparison value with the ValueComparator BLOOM_FILTER to the selections of the probe side 
+	 * of a hash join with this column as build side, which removes most rows without a join partner before the join
+	 * \return object of type boost::any containing a shared_ptr<BloomFilter<T> >, an empty object in case the filter does not have one bit per row*/		
+	virtual const boost::any createBloomFilter(BitmapPtr filter=BitmapPtr())=0;
+	/*! \brief returns the TIDs of the rows of this column whose value occurs in join_column (semi join)
+	 * \details each row appears at most once in the result, no matter how often its value occurs in join_column
+	 * \return PositionListPtr to a PositionList, which represents the result*/		
+	virtual const PositionListPtr semi_join(ColumnPtr join_column)=0;
+	/*! \brief returns the TIDs of the rows of this column whose value does not occur in join_column (anti join)
+	 * \return PositionListPtr to a PositionList, which represents the result*/		
+	virtual const PositionListPtr anti_join(ColumnPtr join_column)=0;
 	/*! \brief joins two columns using the sort merge join algorithm
 	 * \return PositionListPairPtr to a PositionListPair, which represents the result*/		
 	virtual const PositionListPairPtr sort_merge_join(ColumnPtr join_column)=0;
 	/*! \brief joins two columns using the nested loop join algorithm
 	 * \return PositionListPairPtr to a PositionListPair, which represents the result*/			
 	virtual const PositionListPairPtr nested_loop_join(ColumnPtr join_column)=0;
+	/***************** aggregation operations *****************/	
+	/*! \brief computes an aggregate (SUM, MIN, MAX, COUNT, AVG) of all values of a column
+	 * \details SUM returns an int64_t for INT and a double for FLOAT columns, MIN and MAX return a value of the column type, COUNT a size_t and AVG a double.
+	 * The result is empty if the aggregate is not defined, e.g., MIN of an empty column or SUM of a VARCHAR column.
+	 * \return object of type boost::any containing the aggregate*/		
+	virtual const boost::any aggregate(AggregationMethod method)=0;
+	/*! \brief computes an aggregate of the values on the positions in the position list
+	 * \return object of type boost::any containing the aggregate*/		
+	virtual const boost::any aggregate(AggregationMethod method, PositionListPtr tids)=0;
+	/*! \brief computes an aggregate of the values whose bits are set in the bitmap
+	 * \return object of type boost::any containing the aggregate*/		
+	virtual const boost::any aggregate(AggregationMethod method, BitmapPtr tids)=0;
+	/*! \brief groups the values of this column by the values of key_column and aggregates each group
+	 * \details AUTO_GROUP_BY chooses between the hash and sort based algorithm by the estimated number of groups.
+	 * COUNT yields an INT and AVG a FLOAT aggregate column, the other AggregationMethods yield a column of the type of this column.
+	 * \return ColumnPairPtr to a pair of the key column and the aggregate column, a NULL pointer in case an error occured*/		
+	virtual const ColumnPairPtr aggregate_by_keys(ColumnPtr key_column, AggregationMethod method, GroupByAlgorithm algorithm=AUTO_GROUP_BY)=0;
 	/***************** column algebra operations *****************/	
 	/*! \brief adds constant to column
 	 *  \details for all indeces i holds the following property: B[i]=A[i]+new_Value*/		
@@ -120,6 +236,14 @@ class ColumnBase{
 	/*! \brief devide column A with column B
 	 *  \details for all indeces i holds the following property: C[i]=A[i]/B[i]*/				
 	virtual bool division(ColumnPtr column) = 0;	
+	/*! \brief applies an operation with a constant to a copy of the column
+	 *  \details for all indeces i holds the following property: C[i]=A[i] op value, A is not modified
+	 *  \return ColumnPtr to a new materialized column, a NULL pointer in case an error occured*/				
+	virtual const ColumnPtr column_algebra_operation(const boost::any& value, ColumnAlgebraOperation op) = 0;	
+	/*! \brief applies an operation to the values of two columns A and B
+	 *  \details for all indeces i holds the following property: C[i]=A[i] op B[i], A and B are not modified
+	 *  \return ColumnPtr to a new materialized column, a NULL pointer in case an error occured*/				
+	virtual const ColumnPtr column_algebra_operation(ColumnPtr column, ColumnAlgebraOperation op) = 0;	
 	/***************** persistency operations *****************/		
 	/*! \brief store a column on the disc
 	 *  \return true for sucess and false in case an error occured*/	
@@ -148,11 +272,15 @@ class ColumnBase{
 	std::string name_;
 	/*! \brief database type of the column*/		
 	AttributeType db_type_;
+	/*! \brief selectivity of the last adaptive selections, used to choose the result representation*/		
+	double observed_selectivity_;
 //	Table& table_;
 };
 
 /*! \brief makes a smart pointer to a ColumnBase Object visible in the namespace*/
 typedef ColumnBase::ColumnPtr ColumnPtr;
+typedef ColumnBase::ColumnPair ColumnPair;
+typedef ColumnBase::ColumnPairPtr ColumnPairPtr;
 
 typedef std::vector<ColumnPtr> ColumnVector;
 typedef shared_pointer_namespace::shared_ptr<ColumnVector> ColumnVectorPtr;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <core/column_base_typed.hpp>
+#include <core/parallel.hpp>
+#include <core/zone_map.hpp>
+#include <core/column_imprints.hpp>
 #include <iostream>
 #include <fstream>
 
@@ -21,10 +24,13 @@ class Column : public ColumnBaseTyped<T>{
 
 	virtual bool update(TID tid, const boost::any& new_value);
 	virtual bool update(PositionListPtr tid, const boost::any& new_value);	
+	virtual bool update(BitmapPtr tids, const boost::any& new_value);	
 	
 	virtual bool remove(TID tid);
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid);
+	/*! \brief removes all rows whose bits are set in a single pass over the column*/
+	virtual bool remove(BitmapPtr tids);
 	virtual bool clearContent();
 
 	virtual const boost::any get(TID tid);
@@ -34,17 +40,50 @@ class Column : public ColumnBaseTyped<T>{
 	virtual unsigned int getSizeinBytes() const throw();
 
 	virtual const ColumnPtr copy() const;
+	/*! \brief copies dense ranges of TIDs as blocks and prefetches the values of random TIDs, large position lists are processed by several threads*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	/*! \brief copies words of the bitmap with all bits set as blocks of 64 values*/
+	virtual const ColumnPtr gather(BitmapPtr tids);
+	virtual void gatherValues(const TID* tids, size_t number_of_tids, T* result);
 
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 	virtual bool isMaterialized() const  throw();
 	virtual bool isCompressed() const  throw();	
+
+	/*! \brief computes the top k with one bounded heap per thread, which are merged at the end*/
+	virtual const PositionListPtr topk(unsigned int k, SortOrder order);
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief skips segments that cannot match and copies the TIDs of segments that match entirely, each thread processes a disjoint range of segments
+	 *  \details numeric columns also skip or copy cache lines of partially matching segments with their ColumnImprints*/
+	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	/*! \brief computes the result with vector instructions from the value arrays, large columns are processed by several threads*/
+	virtual const ColumnPtr column_algebra_operation(const boost::any& value, ColumnAlgebraOperation op);
+	virtual const ColumnPtr column_algebra_operation(ColumnPtr column, ColumnAlgebraOperation op);
+	/*! \brief computes the bitmap word by word without branches for segments that match partially, each thread computes a disjoint range of segments*/
+	virtual const BitmapPtr bitmap_selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp);
 	
 	virtual T& operator[](const int index);
 
 	std::vector<T>& getContent();
 
+	protected:
+	/*! \brief applies the operation with vector instructions on the value array, large columns are processed by several threads*/
+	virtual bool applyConstantOperation(ColumnAlgebraOperation op, const T& value);
+	/*! \brief applies the operation with vector instructions on the value arrays, if column is a materialized Column<T> as well*/
+	virtual bool applyColumnOperation(ColumnAlgebraOperation op, ColumnBaseTyped<T>& column);
+	/*! \brief aggregates the values with one AggregationState per thread, numeric values are aggregated with vector instructions*/
+	virtual void aggregateAll(AggregationState<T>& state);
+	virtual void aggregatePositions(const PositionList& tids, AggregationState<T>& state);
+	/*! \brief aggregates words with all bits set like a contiguous array of 64 values*/
+	virtual void aggregateBitmap(const Bitmap& tids, AggregationState<T>& state);
+
 	private:
+	/*! \brief computes result[i]=left[i] op value in parallel*/
+	static bool parallel_constant_operation(T* result, const T* left, size_t number_of_values, ColumnAlgebraOperation op, const T& value);
+	/*! \brief computes result[i]=left[i] op right[i] in parallel*/
+	static bool parallel_column_operation(T* result, const T* left, const T* right, size_t number_of_values, ColumnAlgebraOperation op);
 
 		struct Type_TID_Comparator {
   			inline bool operator() (std::pair<T,TID> i, std::pair<T,TID> j) { return (i.first<j.first);}
@@ -53,15 +92,55 @@ class Column : public ColumnBaseTyped<T>{
 	
 	/*! values*/
 	std::vector<T> values_;
+	/*! \brief minimum and maximum of each segment of values_*/
+	ZoneMap<T> zone_map_;
+	/*! \brief bins of the values of each cache line of values_, built by the first selection that can use them*/
+	ColumnImprints<T> imprints_;
 };
 
 
 
+/*! \brief ColumnFilter on a value array, the comparison is resolved once per batch*/
+template<typename T>
+class ValueArrayFilter : public ColumnFilter{
+	public:
+	ValueArrayFilter(const std::vector<T>& values, const ValuePredicate<T>& predicate) : values_(values), predicate_(predicate){}
+
+	virtual size_t filter(TID begin, TID end, TID* result){
+		size_t number_of_matches=0;
+		const T* values = values_.data();
+		predicate_.dispatch([values,begin,end,result,&number_of_matches](const auto& matches){
+			for(TID i=begin;i<end;i++){
+				result[number_of_matches]=i;
+				number_of_matches+=matches(values[i]);
+			}
+		});
+		return number_of_matches;
+	}
+
+	virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result){
+		size_t number_of_matches=0;
+		const T* values = values_.data();
+		predicate_.dispatch([values,candidates,number_of_candidates,result,&number_of_matches](const auto& matches){
+			for(size_t i=0;i<number_of_candidates;i++){
+				TID tid=candidates[i];
+				result[number_of_matches]=tid;
+				number_of_matches+=matches(values[tid]);
+			}
+		});
+		return number_of_matches;
+	}
+
+	private:
+	const std::vector<T>& values_;
+	ValuePredicate<T> predicate_;
+};
+
 /***************** Start of Implementation Section ******************/
 
 	
 	template<class T>
-	Column<T>::Column(const std::string& name, AttributeType db_type) : ColumnBaseTyped<T>(name,db_type), type_tid_comparator(), values_(){
+	Column<T>::Column(const std::string& name, AttributeType db_type) : ColumnBaseTyped<T>(name,db_type), type_tid_comparator(), values_(), zone_map_(), imprints_(){
 
 	}
 
@@ -77,6 +156,11 @@ class Column : public ColumnBaseTyped<T>{
 
 	template<class T>
 	std::vector<T>& Column<T>::getContent(){
+		//the caller may modify the values
+		this->statistics_.invalidate();
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
 		return values_;
 	}
 
@@ -87,6 +171,10 @@ class Column : public ColumnBaseTyped<T>{
 		if(typeid(T)==new_value.type()){
 			 T value = boost::any_cast<T>(new_value);
 			 values_.push_back(value);
+			 this->statistics_.insert(value);
+			 zone_map_.insert(value);
+			 imprints_.insert(value);
+			 this->indexInsert(value);
 			 return true;
 		}
 		return false;
@@ -95,6 +183,10 @@ class Column : public ColumnBaseTyped<T>{
 	template<class T>
 	bool Column<T>::insert(const T& new_value){
 		values_.push_back(new_value);
+		this->statistics_.insert(new_value);
+		zone_map_.insert(new_value);
+		imprints_.insert(new_value);
+		this->indexInsert(new_value);
 		return true;
 	}
 
@@ -102,7 +194,14 @@ class Column : public ColumnBaseTyped<T>{
 	template <typename T> 
 	template <typename InputIterator>
 	bool Column<T>::insert(InputIterator first, InputIterator last){
+		size_t old_size = this->values_.size();
 		this->values_.insert(this->values_.end(),first,last);
+		for(size_t i=old_size;i<this->values_.size();i++){
+			this->statistics_.insert(this->values_[i]);
+			zone_map_.insert(this->values_[i]);
+			imprints_.insert(this->values_[i]);
+			this->indexInsert(this->values_[i]);
+		}
 		return true;
 	}
 
@@ -111,7 +210,11 @@ class Column : public ColumnBaseTyped<T>{
 		if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
 			 T value = boost::any_cast<T>(new_value);
+			 this->statistics_.update(value,1,this->keepsOrder(tid,value));
+			 this->indexUpdate(tid,values_[tid],value);
 			 values_[tid]=value;
+			 zone_map_.update(tid,value);
+			 imprints_.update(tid,value);
 			 return true;
 		}else{
 			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl; 
@@ -128,8 +231,12 @@ class Column : public ColumnBaseTyped<T>{
 			 T value = boost::any_cast<T>(new_value);
 			 for(unsigned int i=0;i<tids->size();i++){
 				TID tid=(*tids)[i];
+				this->indexUpdate(tid,values_[tid],value);
 				values_[tid]=value;
+				zone_map_.update(tid,value);
+				imprints_.update(tid,value);
 			 }
+			 this->statistics_.update(value,tids->size());
 			 return true;
 		}else{
 			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl; 
@@ -140,9 +247,40 @@ class Column : public ColumnBaseTyped<T>{
 
 
 
+	template<class T>
+	bool Column<T>::update(BitmapPtr tids, const boost::any& new_value){
+		if(!tids || tids->size()!=values_.size())
+			return false;
+		if(new_value.empty()) return false;
+		if(typeid(T)==new_value.type()){
+			 T value = boost::any_cast<T>(new_value);
+			 const std::vector<uint64_t>& words = tids->getWords();
+			 for(size_t i=0;i<words.size();i++){
+				uint64_t word = words[i];
+				while(word){
+					const TID tid = i*64+__builtin_ctzll(word);
+					this->indexUpdate(tid,values_[tid],value);
+					values_[tid]=value;
+					zone_map_.update(tid,value);
+					imprints_.update(tid,value);
+					word &= word-1;
+				}
+			 }
+			 this->statistics_.update(value,tids->count());
+			 return true;
+		}else{
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl; 
+		}
+		return false;		
+	}
+
 	template<class T>
 	bool Column<T>::remove(TID tid){
+		this->indexRemove(tid,values_[tid]);
 		values_.erase(values_.begin()+tid);
+		this->statistics_.remove(1);
+		zone_map_.invalidate();
+		imprints_.invalidate();
 		return true;
 	}
 	
@@ -160,6 +298,10 @@ class Column : public ColumnBaseTyped<T>{
 
 		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit)
 			values_.erase(values_.begin()+(*rit));
+		this->statistics_.remove(tids->size());
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
 
 		/*
 		//delete tuples in reverse order, otherwise the first deletion would invalidate all other tids
@@ -174,9 +316,33 @@ class Column : public ColumnBaseTyped<T>{
 		return true;			
 	}
 
+	template<class T>
+	bool Column<T>::remove(BitmapPtr tids){
+		if(!tids || tids->size()!=values_.size())
+			return false;
+		//move the remaining values to the front, so that every value is moved at most once
+		size_t number_of_remaining_values=0;
+		for(size_t i=0;i<values_.size();i++){
+			if(!tids->test(i)){
+				if(number_of_remaining_values!=i) values_[number_of_remaining_values]=values_[i];
+				number_of_remaining_values++;
+			}
+		}
+		this->statistics_.remove(values_.size()-number_of_remaining_values);
+		values_.resize(number_of_remaining_values);
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
+		return true;
+	}
+
 	template<class T>
 	bool Column<T>::clearContent(){
 		values_.clear();
+		this->statistics_.clear();
+		zone_map_.clear();
+		imprints_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -206,6 +372,47 @@ class Column : public ColumnBaseTyped<T>{
 	const ColumnPtr Column<T>::copy() const{
 		return ColumnPtr(new Column<T>(*this));
 	}
+
+	template<class T>
+	const ColumnPtr Column<T>::gather(PositionListPtr tids){
+		if(!tids || !is_valid_position_list(*tids,values_.size())) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		result->values_.resize(tids->size());
+		T* result_values = result->values_.data();
+		const T* values = values_.data();
+		const TID* positions = tids->data();
+		parallel_for_chunks(tids->size(),getNumberOfThreads(tids->size()),
+			[result_values,values,positions](unsigned int, size_t begin, size_t end){
+				gather_values(result_values+begin,values,positions+begin,end-begin);
+			});
+		return result;
+	}
+
+	template<class T>
+	void Column<T>::gatherValues(const TID* tids, size_t number_of_tids, T* result){
+		gather_values(result,values_.data(),tids,number_of_tids);
+	}
+
+	template<class T>
+	const ColumnPtr Column<T>::gather(BitmapPtr tids){
+		if(!tids || tids->size()!=values_.size()) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		result->values_.resize(tids->count());
+		T* result_values = result->values_.data();
+		const std::vector<uint64_t>& words = tids->getWords();
+		for(size_t i=0;i<words.size();i++){
+			uint64_t word = words[i];
+			if(word==~uint64_t(0)){
+				result_values = std::copy(values_.begin()+i*64,values_.begin()+(i+1)*64,result_values);
+				continue;
+			}
+			while(word){
+				*result_values++ = values_[i*64+__builtin_ctzll(word)];
+				word &= word-1;
+			}
+		}
+		return result;
+	}
 	/***************** relational operations on Columns which return lookup tables *****************/
 //	template<class T>
 //	const std::vector<TID> Column<T>::sort(const ComputeDevice comp_dev) const {
@@ -258,6 +465,10 @@ class Column : public ColumnBaseTyped<T>{
 		boost::archive::binary_iarchive ia(infile);
 		ia >> values_;
 		infile.close();
+		this->statistics_.invalidate();
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
 
 
 		return true;
@@ -272,6 +483,267 @@ class Column : public ColumnBaseTyped<T>{
 		return false;
 	}
 
+	template<class T>
+	const PositionListPtr Column<T>::topk(unsigned int k, SortOrder order){
+		if(k>=values_.size()) return this->sort(order);
+
+		const unsigned int number_of_threads = getNumberOfThreads(values_.size());
+		std::vector<TopKHeap<T> > heaps(number_of_threads,TopKHeap<T>(k,order));
+		const T* values = values_.data();
+		parallel_for_chunks(values_.size(),number_of_threads,
+			[values,&heaps](unsigned int thread_id, size_t begin, size_t end){
+				TopKHeap<T>& heap = heaps[thread_id];
+				for(size_t i=begin;i<end;++i){
+					heap.push(values[i],i);
+				}
+			});
+
+		for(unsigned int i=1;i<heaps.size();++i){
+			heaps[0].merge(heaps[i]);
+		}
+		return heaps[0].getTIDs();
+	}
+
+	template<class T>
+	const PositionListPtr Column<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return this->parallel_selection(value_for_comparison,comp,getNumberOfThreads(values_.size()));
+	}
+
+	template<class T>
+	const PositionListPtr Column<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		//a sorted column is searched instead of scanned
+		TID range_begin, range_end;
+		if(this->findSortedRange(predicate,range_begin,range_end)){
+			PositionListPtr result_tids( new PositionList(range_end-range_begin));
+			for(TID i=range_begin;i<range_end;++i){
+				(*result_tids)[i-range_begin]=i;
+			}
+			return result_tids;
+		}
+		PositionListPtr index_tids = this->indexSelection(predicate);
+		if(index_tids) return index_tids;
+		zone_map_.rebuildIfOutdated(values_);
+		const ZoneMap<T>& zone_map = zone_map_;
+		//the imprints are built by the first selection on a numeric column
+		uint64_t may_match_mask=0;
+		uint64_t full_match_mask=0;
+		bool use_imprints=false;
+		if(ImprintsTraits<T>::supported && comp!=NOT_EQUAL && comp!=BLOOM_FILTER){
+			imprints_.rebuildIfOutdated(values_);
+			use_imprints = imprints_.getMasks(predicate,may_match_mask,full_match_mask);
+		}
+		const ColumnImprints<T>& imprints = imprints_;
+		const T* values = values_.data();
+		const size_t number_of_rows = values_.size();
+		return parallel_scan(number_of_rows,number_of_threads,
+			[values,&zone_map,&imprints,use_imprints,may_match_mask,full_match_mask,&predicate](size_t first_row, size_t last_row, PositionList& result){
+				//a morsel lies within one segment, but a single threaded scan processes all segments in one call
+				size_t begin=first_row;
+				while(begin<last_row){
+					const size_t segment = begin/ZONE_MAP_SEGMENT_SIZE;
+					const size_t end = std::min((segment+1)*ZONE_MAP_SEGMENT_SIZE,last_row);
+					switch(zone_map.match(segment,predicate)){
+						case ZoneMap<T>::NO_MATCH: break;
+						case ZoneMap<T>::FULL_MATCH:
+							for(size_t i=begin;i<end;++i){
+								result.push_back(i);
+							}
+							break;
+						case ZoneMap<T>::PARTIAL_MATCH:
+							if(!use_imprints){
+								predicate.dispatch([values,begin,end,&result](const auto& matches){
+									for(size_t i=begin;i<end;++i){
+										if(matches(values[i])) result.push_back(i);
+									}
+								});
+								break;
+							}
+							//morsels and segments consist of whole cache lines, only the last cache line of the column may be partially filled
+							predicate.dispatch([values,begin,end,&imprints,may_match_mask,full_match_mask,&result](const auto& matches){
+								const size_t values_per_cache_line = ColumnImprints<T>::VALUES_PER_CACHE_LINE;
+								for(size_t line_begin=begin;line_begin<end;line_begin+=values_per_cache_line){
+									const uint64_t imprint = imprints.getImprint(line_begin/values_per_cache_line);
+									const size_t line_end = std::min(line_begin+values_per_cache_line,end);
+									if((imprint & may_match_mask)==0) continue;
+									if((imprint & ~full_match_mask)==0){
+										for(size_t i=line_begin;i<line_end;++i){
+											result.push_back(i);
+										}
+									}else{
+										for(size_t i=line_begin;i<line_end;++i){
+											if(matches(values[i])) result.push_back(i);
+										}
+									}
+								}
+							});
+							break;
+					}
+					begin=end;
+				}
+			});
+	}
+
+	template<class T>
+	const BitmapPtr Column<T>::bitmap_selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		const size_t number_of_rows = values_.size();
+		BitmapPtr bitmap( new Bitmap(number_of_rows));
+		TID range_begin, range_end;
+		if(this->findSortedRange(predicate,range_begin,range_end)){
+			bitmap->setRange(range_begin,range_end);
+			return bitmap;
+		}
+		zone_map_.rebuildIfOutdated(values_);
+		const ZoneMap<T>& zone_map = zone_map_;
+		const T* values = values_.data();
+		uint64_t* words = bitmap->getWords().data();
+		//morsels consist of whole words, so threads processing different morsels never write the same word
+		parallel_for_chunks(bitmap->getWords().size(),getNumberOfThreads(number_of_rows),
+			[values,words,number_of_rows,&zone_map,&predicate](unsigned int, size_t first_word, size_t last_word){
+				size_t begin=first_word;
+				while(begin<last_word){
+					const size_t segment = begin*64/ZONE_MAP_SEGMENT_SIZE;
+					const size_t end = std::min((segment+1)*ZONE_MAP_SEGMENT_SIZE/64,last_word);
+					switch(zone_map.match(segment,predicate)){
+						case ZoneMap<T>::NO_MATCH: break;
+						case ZoneMap<T>::FULL_MATCH:
+							for(size_t w=begin;w<end;++w){
+								const size_t rows_in_word = std::min<size_t>(64,number_of_rows-w*64);
+								words[w] = (rows_in_word==64) ? ~uint64_t(0) : (uint64_t(1) << rows_in_word)-1;
+							}
+							break;
+						case ZoneMap<T>::PARTIAL_MATCH:
+							predicate.dispatch([values,words,number_of_rows,begin,end](const auto& matches){
+								for(size_t w=begin;w<end;++w){
+									const size_t first_row = w*64;
+									const size_t last_row = std::min(first_row+64,number_of_rows);
+									uint64_t word=0;
+									for(size_t i=first_row;i<last_row;++i){
+										word |= uint64_t(matches(values[i])) << (i-first_row);
+									}
+									words[w]=word;
+								}
+							});
+							break;
+					}
+					begin=end;
+				}
+			},MORSEL_SIZE/64);
+		return bitmap;
+	}
+
+	template<class T>
+	bool Column<T>::parallel_constant_operation(T* result, const T* left, size_t number_of_values, ColumnAlgebraOperation op, const T& value){
+		if(!is_valid_operand(op,value)) return false;
+		parallel_for_chunks(number_of_values,getNumberOfThreads(number_of_values),
+			[result,left,op,&value](unsigned int, size_t begin, size_t end){
+				apply_constant_operation(result+begin,left+begin,end-begin,op,value);
+			});
+		return true;
+	}
+
+	template<class T>
+	bool Column<T>::parallel_column_operation(T* result, const T* left, const T* right, size_t number_of_values, ColumnAlgebraOperation op){
+		if(!is_valid_operand_array(op,right,number_of_values)) return false;
+		parallel_for_chunks(number_of_values,getNumberOfThreads(number_of_values),
+			[result,left,right,op](unsigned int, size_t begin, size_t end){
+				apply_column_operation(result+begin,left+begin,right+begin,end-begin,op);
+			});
+		return true;
+	}
+
+	template<class T>
+	bool Column<T>::applyConstantOperation(ColumnAlgebraOperation op, const T& value){
+		this->statistics_.invalidate();
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
+		return parallel_constant_operation(values_.data(),values_.data(),values_.size(),op,value);
+	}
+
+	template<class T>
+	bool Column<T>::applyColumnOperation(ColumnAlgebraOperation op, ColumnBaseTyped<T>& column){
+		Column<T>* materialized_column = dynamic_cast<Column<T>*>(&column);
+		if(!materialized_column) return ColumnBaseTyped<T>::applyColumnOperation(op,column);
+		this->statistics_.invalidate();
+		zone_map_.invalidate();
+		imprints_.invalidate();
+		this->invalidateIndex();
+		return parallel_column_operation(values_.data(),values_.data(),materialized_column->values_.data(),values_.size(),op);
+	}
+
+	template<class T>
+	const ColumnPtr Column<T>::column_algebra_operation(const boost::any& value, ColumnAlgebraOperation op){
+		if(value.empty() || typeid(T)!=value.type()) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		result->values_.resize(values_.size());
+		if(!parallel_constant_operation(result->values_.data(),values_.data(),values_.size(),op,boost::any_cast<T>(value))) return ColumnPtr();
+		return result;
+	}
+
+	template<class T>
+	const ColumnPtr Column<T>::column_algebra_operation(ColumnPtr column, ColumnAlgebraOperation op){
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return ColumnPtr();
+		Column<T>* materialized_column = dynamic_cast<Column<T>*>(typed_column.get());
+		if(!materialized_column) return ColumnBaseTyped<T>::column_algebra_operation(column,op);
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		result->values_.resize(values_.size());
+		if(!parallel_column_operation(result->values_.data(),values_.data(),materialized_column->values_.data(),values_.size(),op)) return ColumnPtr();
+		return result;
+	}
+
+	template<class T>
+	void Column<T>::aggregateAll(AggregationState<T>& state){
+		const T* values = values_.data();
+		std::vector<AggregationState<T> > states(getNumberOfThreads(values_.size()));
+		parallel_for_chunks(values_.size(),states.size(),
+			[values,&states](unsigned int thread_id, size_t begin, size_t end){
+				aggregate_values(values+begin,end-begin,states[thread_id]);
+			});
+		for(size_t i=0;i<states.size();i++){
+			state.merge(states[i]);
+		}
+	}
+
+	template<class T>
+	void Column<T>::aggregatePositions(const PositionList& tids, AggregationState<T>& state){
+		for(size_t i=0;i<tids.size();i++){
+			state.add(values_[tids[i]]);
+		}
+	}
+
+	template<class T>
+	void Column<T>::aggregateBitmap(const Bitmap& tids, AggregationState<T>& state){
+		const T* values = values_.data();
+		const std::vector<uint64_t>& words = tids.getWords();
+		std::vector<AggregationState<T> > states(getNumberOfThreads(values_.size()));
+		parallel_for_chunks(words.size(),states.size(),
+			[values,&words,&states](unsigned int thread_id, size_t begin, size_t end){
+				AggregationState<T>& thread_state = states[thread_id];
+				for(size_t i=begin;i<end;i++){
+					uint64_t word = words[i];
+					if(word==~uint64_t(0)){
+						aggregate_values(values+i*64,64,thread_state);
+						continue;
+					}
+					while(word){
+						thread_state.add(values[i*64+__builtin_ctzll(word)]);
+						word &= word-1;
+					}
+				}
+			},MORSEL_SIZE/64);
+		for(size_t i=0;i<states.size();i++){
+			state.merge(states[i]);
+		}
+	}
+
+	template<class T>
+	const ColumnFilterPtr Column<T>::createFilter(const boost::any& value_for_comparison, const ValueComparator comp){
+		return ColumnFilterPtr(new ValueArrayFilter<T>(values_,this->getPredicate(value_for_comparison,comp)));
+	}
+
 	template<class T>
 	T& Column<T>::operator[](const int index){
 		
@@ -2,13 +2,24 @@
 #pragma once
 
 #include <core/base_column.hpp>
+#include <core/radix_sort.hpp>
+#include <core/top_k_heap.hpp>
+#include <core/predicate.hpp>
+#include <core/bitmap.hpp>
+#include <core/aggregation.hpp>
+#include <core/group_by.hpp>
+#include <core/column_algebra.hpp>
+#include <core/gather.hpp>
+#include <core/join.hpp>
+#include <core/column_statistics.hpp>
+#include <core/sorted_index.hpp>
+#include <core/hash_index.hpp>
 #include <iostream>
 
 #include <utility>
 #include <functional>
 #include <algorithm>
 
-#include <boost/unordered_map.hpp>
 #include <boost/any.hpp>
 
 //#include <core/column.hpp>
@@ -41,10 +52,14 @@ class ColumnBaseTyped : public ColumnBase{
 	virtual bool insert(const T& new_Value)=0;
 	virtual bool update(TID tid, const boost::any& new_value) = 0;
 	virtual bool update(PositionListPtr tid, const boost::any& new_value) = 0;	
+	/*! \brief converts the bitmap to a PositionList and updates the values in the PositionList*/
+	virtual bool update(BitmapPtr tids, const boost::any& new_value);
 	
 	virtual bool remove(TID tid)=0;
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid)=0;
+	/*! \brief converts the bitmap to a PositionList and removes the values in the PositionList*/
+	virtual bool remove(BitmapPtr tids);
 	virtual bool clearContent()=0;
 
 	virtual const boost::any get(TID tid)=0;
@@ -52,17 +67,56 @@ class ColumnBaseTyped : public ColumnBase{
 	virtual void print() const throw()=0;
 	virtual size_t size() const throw()=0;
 	virtual unsigned int getSizeinBytes() const throw()=0;
+	/*! \brief rebuilds the statistics from the values of the column if they are outdated*/
+	virtual const TypedColumnStatistics<T>& getColumnStatistics();
 
 	virtual const ColumnPtr copy() const=0;
+	/*! \brief the generic gather fetches each value with operator[], encodings with a faster access path override it*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	virtual const ColumnPtr gather(BitmapPtr tids);
+	/*! \brief copies the values on the positions tids[0..number_of_tids) to result, operators that process batches of rows use it to decode a batch
+	 *  \details the generic implementation gathers the values into a materialized column*/
+	virtual void gatherValues(const TID* tids, size_t number_of_tids, T* result);
 	/***************** relational operations on Columns which return lookup tables *****************/
 	virtual const PositionListPtr sort(SortOrder order); 
+	virtual const PositionListPtr topk(unsigned int k, SortOrder order); 
 	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
 	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	/*! \brief evaluates the filter returned by createFilter batch by batch, so compressed columns evaluate the predicate on their compressed representation*/
+	virtual const BitmapPtr bitmap_selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief attaches a SortedIndex to the column, which selection uses for point lookups and selective range lookups
+	 *  \details the index is maintained on insert, update and remove of single rows and rebuilt before the next lookup after other modifications*/
+	void createSortedIndex();
+	void dropSortedIndex();
+	bool hasSortedIndex() const throw();
+	/*! \brief looks up the rows matching the predicate in the SortedIndex of the column
+	 *  \return the TIDs in ascending order, or a NULL pointer if the column has no SortedIndex or the ValueComparator cannot use it (NOT_EQUAL, BLOOM_FILTER)*/
+	const PositionListPtr index_scan(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief attaches a HashIndex to the column, which selection uses for EQUAL and IN lookups and hash joins use as hash table of this column
+	 *  \details the index is maintained on insert and update of single rows and rebuilt before the next lookup after other modifications*/
+	void createHashIndex();
+	void dropHashIndex();
+	bool hasHashIndex() const throw();
 	//join algorithms
+	virtual const PositionListPairPtr join(ColumnPtr join_column, JoinAlgorithm algorithm=AUTO_JOIN);
+	/*! \brief builds the hash table on this column, unless it has a HashIndex, and probes it with join_column using several threads*/
 	virtual const PositionListPairPtr hash_join(ColumnPtr join_column);
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column, BitmapPtr build_filter, BitmapPtr probe_filter);
+	/*! \brief probes the HashIndex of this column, if it has one, and a JoinHashTable on the decoded values otherwise*/
+	virtual const ColumnProbePtr createProbe(ColumnPtr probe_column);
+	/*! \brief semi and anti join collect the distinct values of join_column and evaluate them as IN predicate on this column, 
+	 *  so each row is checked for membership only once and compressed columns evaluate the predicate on their compressed representation*/
+	virtual const PositionListPtr semi_join(ColumnPtr join_column);
+	virtual const boost::any createBloomFilter(BitmapPtr filter=BitmapPtr());
+	virtual const PositionListPtr anti_join(ColumnPtr join_column);
 	virtual const PositionListPairPtr sort_merge_join(ColumnPtr join_column);
 	virtual const PositionListPairPtr nested_loop_join(ColumnPtr join_column);
 
+	/*! \brief aggregation operations compute an AggregationState with the aggregateAll, aggregatePositions and aggregateBitmap methods*/
+	virtual const boost::any aggregate(AggregationMethod method);
+	virtual const boost::any aggregate(AggregationMethod method, PositionListPtr tids);
+	virtual const boost::any aggregate(AggregationMethod method, BitmapPtr tids);
 
 	virtual bool add(const boost::any& new_Value);
 	//vector addition between columns			
@@ -77,8 +131,12 @@ class ColumnBaseTyped : public ColumnBase{
 	virtual bool division(const boost::any& new_Value);	
 	virtual bool division(ColumnPtr join_column);	
 
-	//template <typename U, typename BinaryOperator>
-	//std::pair<ColumnPtr,ColumnPtr> aggregate_by_keys(ColumnBaseTyped<U>* keys, BinaryOperator binary_op) const;
+	/*! \brief materializes the column and applies the operation to the materialized copy*/
+	virtual const ColumnPtr column_algebra_operation(const boost::any& value, ColumnAlgebraOperation op);	
+	virtual const ColumnPtr column_algebra_operation(ColumnPtr column, ColumnAlgebraOperation op);	
+
+	/*! \brief dispatches on the type of the key column and calls group_by*/
+	virtual const ColumnPairPtr aggregate_by_keys(ColumnPtr key_column, AggregationMethod method, GroupByAlgorithm algorithm=AUTO_GROUP_BY);
 
 	virtual bool store(const std::string& path) = 0;
 	virtual bool load(const std::string& path) = 0;
@@ -92,11 +150,159 @@ class ColumnBaseTyped : public ColumnBase{
 	 * */
 	virtual T& operator[](const int index) = 0;
 	inline bool operator==(ColumnBaseTyped<T>& column);
+	/*! \brief returns the codes of a dictionary compressed column, value i of the column is (*getDictionary())[(*getDictionaryCodes())[i]]
+	 * \return a NULL pointer if the column is not dictionary compressed*/
+	virtual const std::vector<int>* getDictionaryCodes() const;
+	/*! \brief returns the dictionary of a dictionary compressed column
+	 * \return a NULL pointer if the column is not dictionary compressed*/
+	virtual const std::vector<T>* getDictionary() const;
+
+	protected:
+		/*! \brief statistics of the column, derived classes update them in insert, update, remove and clearContent*/
+		TypedColumnStatistics<T> statistics_;
+		/*! \brief secondary index on the values, which is only maintained if has_sorted_index_ is true*/
+		SortedIndex<T> sorted_index_;
+		bool has_sorted_index_;
+		/*! \brief hash table on the values, which is only maintained if has_hash_index_ is true*/
+		HashIndex<T> hash_index_;
+		bool has_hash_index_;
+		/*! \brief return the index after rebuilding it from the values of the column, if it is outdated*/
+		const SortedIndex<T>& getSortedIndex();
+		const HashIndex<T>& getHashIndex();
+		/*! \brief returns the result of a selection from the HashIndex or the SortedIndex, if the column has one that supports the ValueComparator 
+		 *  and the predicate is selective enough, and a NULL pointer otherwise*/
+		const PositionListPtr indexSelection(const ValuePredicate<T>& predicate);
+		/*! \brief maintain the SortedIndex and the HashIndex, derived classes call them next to the statistics hooks, indexInsert for a value appended to the column*/
+		void indexInsert(const T& value);
+		void indexUpdate(TID tid, const T& old_value, const T& new_value);
+		void indexRemove(TID tid, const T& old_value);
+		void invalidateIndex() throw();
+		/*! \brief returns true if the column is known to be sorted in order, the statistics are not rebuilt*/
+		bool isSorted(SortOrder order) const throw();
+		/*! \brief returns the TIDs in ascending order if the column is known to be sorted in order, which is the result of a stable sort, and a NULL pointer otherwise*/
+		const PositionListPtr getSortedTIDs(SortOrder order) const;
+		/*! \brief finds the rows [begin,end) matching the predicate by binary search, accessing O(log n) values with operator[]
+		 *  \return false if the column is not known to be sorted or the ValueComparator does not select a range of a sorted column (NOT_EQUAL, IN, BLOOM_FILTER)*/
+		bool findSortedRange(const ValuePredicate<T>& predicate, TID& begin, TID& end);
+		/*! \brief returns the first row in [0,size()) for which is_before(value) is false, is_before has to be true for a prefix of the rows*/
+		template<typename Predicate>
+		TID partitionPoint(Predicate is_before);
+		/*! \brief returns true if value lies between the values of the neighbors of row tid, so setting row tid to value keeps a sorted column sorted*/
+		bool keepsOrder(TID tid, const T& value);
+		/*! \brief applies an operation with a constant to all values, used by add, minus, multiply and division with a constant
+		 *  \details the generic implementation modifies the values with operator[], compressed columns override it to modify their compressed representation*/
+		virtual bool applyConstantOperation(ColumnAlgebraOperation op, const T& value);
+		/*! \brief applies an operation with the values of column to all values, used by add, minus, multiply and division with a column
+		 *  \details the generic implementation decodes both columns with operator[], combines the values and inserts the results again*/
+		virtual bool applyColumnOperation(ColumnAlgebraOperation op, ColumnBaseTyped<T>& column);
+		/*! \brief returns the column as a typed pointer, if it has type T and the same size as this column, and a NULL pointer otherwise*/
+		const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > getOperandColumn(ColumnPtr column) const;
+		/*! \brief copies the values into a new materialized column*/
+		const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > materialize();
+		/*! \brief adds all values of the column to state, the generic implementation accesses the values with operator[]*/
+		virtual void aggregateAll(AggregationState<T>& state);
+		/*! \brief adds the values on the positions in tids to state*/
+		virtual void aggregatePositions(const PositionList& tids, AggregationState<T>& state);
+		/*! \brief adds the values whose bits are set in tids to state*/
+		virtual void aggregateBitmap(const Bitmap& tids, AggregationState<T>& state);
+		/*! \brief appends the values of the column to values, values may contain duplicates
+		 *  \details the generic implementation gathers all values into a materialized column*/
+		virtual void getDistinctValues(std::vector<T>& values);
+		/*! \brief returns the sorted distinct values of join_column as key set of a semi or anti join*/
+		const std::vector<T> getJoinKeys(ColumnPtr join_column);
+		/*! \brief creates the typed predicate of a selection, terminates the program in case the comparison value has the wrong type*/
+		const ValuePredicate<T> getPredicate(const boost::any& value_for_comparison, const ValueComparator comp) const;
+		/*! \brief strict weak ordering on the value of a (value,TID) pair*/
+		struct ValueLesser {
+			//NaNs are placed behind all other values, like the radix sort does
+			inline bool operator() (const std::pair<T,TID>& i, const std::pair<T,TID>& j) const { return i.first<j.first || (is_unordered(j.first,j.first) && !is_unordered(i.first,i.first)); }
+		};
+		/*! \brief strict weak ordering on the value of a (value,TID) pair, in descending order*/
+		struct ValueGreater {
+			inline bool operator() (const std::pair<T,TID>& i, const std::pair<T,TID>& j) const { return ValueLesser()(j,i); }
+		};
 };
 
 
+/*! \brief generic ColumnFilter, which accesses the values of a typed column with operator[]*/
+template<class T>
+class ColumnFilterTyped : public ColumnFilter{
+	public:
+	ColumnFilterTyped(ColumnBaseTyped<T>& column, const ValuePredicate<T>& predicate) : column_(column), predicate_(predicate){}
+
+	virtual size_t filter(TID begin, TID end, TID* result){
+		size_t number_of_matches=0;
+		for(TID i=begin;i<end;i++){
+			result[number_of_matches]=i;
+			number_of_matches+=predicate_(column_[i]);
+		}
+		return number_of_matches;
+	}
+
+	virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result){
+		size_t number_of_matches=0;
+		for(size_t i=0;i<number_of_candidates;i++){
+			TID tid=candidates[i];
+			result[number_of_matches]=tid;
+			number_of_matches+=predicate_(column_[tid]);
+		}
+		return number_of_matches;
+	}
+
+	private:
+	ColumnBaseTyped<T>& column_;
+	ValuePredicate<T> predicate_;
+};
+
+/*! \brief ColumnProbe on a hash table with the probe interface of a JoinHashTable, e.g., a HashIndex, which must outlive the probe*/
+template<class T, class HashTable>
+class ColumnProbeTyped : public ColumnProbe{
+	public:
+	ColumnProbeTyped(const HashTable& hash_table, ColumnBaseTyped<T>& probe_column) : hash_table_(hash_table), probe_column_(probe_column), probe_keys_(){}
+
+	virtual void probe(const TID* candidates, size_t number_of_candidates, std::vector<TID>& positions, std::vector<TID>& build_tids){
+		probe_keys_.resize(number_of_candidates);
+		probe_column_.gatherValues(candidates,number_of_candidates,probe_keys_.data());
+		for(size_t i=0;i<number_of_candidates;i++){
+			hash_table_.probe(probe_keys_[i],[&positions,&build_tids,i](TID tid){
+				positions.push_back(TID(i));
+				build_tids.push_back(tid);
+			});
+		}
+	}
+
+	private:
+	const HashTable& hash_table_;
+	ColumnBaseTyped<T>& probe_column_;
+	/*! \brief values of the current batch*/
+	std::vector<T> probe_keys_;
+};
+
+/*! \brief ColumnProbe that owns a JoinHashTable on the decoded values of the build column*/
+template<class T>
+class JoinHashTableProbe : public ColumnProbe{
+	public:
+	JoinHashTableProbe(ColumnBaseTyped<T>& build_column, ColumnBaseTyped<T>& probe_column) 
+		: build_keys_(decode_keys(build_column)), hash_table_(build_keys_), probe_(hash_table_,probe_column){}
+
+	virtual void probe(const TID* candidates, size_t number_of_candidates, std::vector<TID>& positions, std::vector<TID>& build_tids){
+		probe_.probe(candidates,number_of_candidates,positions,build_tids);
+	}
+
+	private:
+	static const std::vector<T> decode_keys(ColumnBaseTyped<T>& column){
+		std::vector<T> keys;
+		decode_values(column,keys);
+		return keys;
+	}
+
+	std::vector<T> build_keys_;
+	JoinHashTable<T> hash_table_;
+	ColumnProbeTyped<T,JoinHashTable<T> > probe_;
+};
+
 	template<class T>
-	ColumnBaseTyped<T>::ColumnBaseTyped(const std::string& name, AttributeType db_type) : ColumnBase(name,db_type){
+	ColumnBaseTyped<T>::ColumnBaseTyped(const std::string& name, AttributeType db_type) : ColumnBase(name,db_type), statistics_(), sorted_index_(), has_sorted_index_(false), hash_index_(), has_hash_index_(false){
 
 	}
 
@@ -112,9 +318,12 @@ const std::type_info& ColumnBaseTyped<T>::type() const throw(){
 
 template<class T>
 const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
+	PositionListPtr sorted_tids = this->getSortedTIDs(order);
+	if(sorted_tids) return sorted_tids;
 
 	PositionListPtr ids = PositionListPtr( new PositionList());
 		std::vector<std::pair<T,TID> > v;
+		v.reserve(this->size());
 
 		for(unsigned int i=0;i<this->size();i++){
 			v.push_back (std::pair<T,TID>((*this)[i],i) );
@@ -122,16 +331,16 @@ const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
 
 		//TODO: change implementation, so that no copy operations are required -> use boost zip iterators!
 
+		//compare the values only, stable_sort keeps the TIDs of equal values in ascending order
 	  	if(order==ASCENDING){
-			//tbb::parallel_sort(v.begin(),v.end(),std::less_equal<std::pair<T,TID> >());
-	  		std::stable_sort(v.begin(),v.end(),std::less_equal<std::pair<T,TID> >());
+	  		std::stable_sort(v.begin(),v.end(),ValueLesser());
 		}else if(order==DESCENDING){
-			//tbb::parallel_sort(v.begin(),v.end(),std::greater_equal<std::pair<T,TID> >());
-			std::stable_sort(v.begin(),v.end(),std::greater_equal<std::pair<T,TID> >()); 
+			std::stable_sort(v.begin(),v.end(),ValueGreater()); 
 		}else{
 			std::cout << "FATAL ERROR: ColumnBaseTyped<T>::sort(): Unknown Sorting Order!" << std::endl;
 		}
 
+		ids->reserve(v.size());
 		for(unsigned int i=0;i<v.size();i++){
 			ids->push_back(v[i].second);
 		}
@@ -139,101 +348,579 @@ const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
 		return ids;
 }
 
-
+/*! \brief sorts a numeric column with an LSD radix sort on order preserving keys
+ *  \details DESCENDING is handled by complementing the keys, so the sort stays stable for both orders*/
 template<class T>
-const PositionListPtr ColumnBaseTyped<T>::parallel_selection(const boost::any&, const ValueComparator, unsigned int){
+const PositionListPtr radix_sort(ColumnBaseTyped<T>& column, SortOrder order){
+	typedef typename RadixKey<T>::KeyType KeyType;
 
-		PositionListPtr result_tids( new PositionList());
+	if(order!=ASCENDING && order!=DESCENDING){
+		std::cout << "FATAL ERROR: radix_sort(): Unknown Sorting Order!" << std::endl;
+		return PositionListPtr( new PositionList());
+	}
+
+	const size_t number_of_rows = column.size();
+	const unsigned int number_of_threads = getNumberOfThreads(number_of_rows);
+	const KeyType mask = (order==ASCENDING) ? KeyType(0) : ~KeyType(0);
+	//operator[] of compressed columns is slow and not thread safe
+	std::vector<T> values;
+	decode_values(column,values);
+	std::vector<std::pair<KeyType,TID> > v(number_of_rows);
+	parallel_for_chunks(number_of_rows,number_of_threads,
+		[&values,&v,mask](unsigned int, size_t begin, size_t end){
+			for(TID i=begin;i<end;i++){
+				v[i].first = RadixKey<T>::encode(values[i]) ^ mask;
+				v[i].second = i;
+			}
+		});
 
-		return result_tids;
+	parallel_radix_sort_pairs(v,number_of_threads);
+
+	PositionListPtr ids = PositionListPtr( new PositionList(number_of_rows));
+	PositionList& result = *ids;
+	parallel_for_chunks(number_of_rows,number_of_threads,
+		[&v,&result](unsigned int, size_t begin, size_t end){
+			for(size_t i=begin;i<end;i++){
+				result[i]=v[i].second;
+			}
+		});
+	return ids;
 }
 
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::topk(unsigned int k, SortOrder order){
+	if(k>=this->size()) return this->sort(order);
 
+	TopKHeap<T> heap(k,order);
+	for(TID i=0;i<this->size();i++){
+		heap.push((*this)[i],i);
+	}
+	return heap.getTIDs();
+}
 
 template<class T>
-const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
-		if(value_for_comparison.type()!=typeid(T)){
+const ValuePredicate<T> ColumnBaseTyped<T>::getPredicate(const boost::any& value_for_comparison, const ValueComparator comp) const{
+		ValuePredicate<T> predicate(value_for_comparison,comp);
+		if(!predicate.isValid()){
 			std::cout << "Fatal Error!!! Typemismatch for column " << name_ << std::endl;
 			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
 			exit(-1);
 		}
-			
-		T value = boost::any_cast<T>(value_for_comparison);
-	
+		return predicate;
+}
+
+/*! \details the generic implementation accesses the values with operator[], which is not thread safe for all columns, so it runs serially*/
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int){
+		return this->selection(value_for_comparison,comp);
+}
 
-		PositionListPtr result_tids;
 
-				result_tids = PositionListPtr(new PositionList());
 
-				if(!quiet) std::cout << "Using CPU for Selection..." << std::endl;
-				for(TID i=0;i<this->size();i++){
-		
-					//boost::any value = column->get(i);
-					//val = values_[i];
-			
-					if(comp==EQUAL){
-					if(value==(*this)[i]){
-						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
-					}
-					}else if(comp==LESSER){
-					if((*this)[i]<value){
-						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
-					}
-					}else if(comp==GREATER){
-					if((*this)[i]>value){
-						result_tids->push_back(i);
-						//result_table->insert(this->fetchTuple(i));
-					}
-					}else{
-
-					}
-				}	
-
-	    //}
+template<class T>
+bool ColumnBaseTyped<T>::update(BitmapPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		return this->update(tids->toPositionList(),new_value);
+}
+
+template<class T>
+bool ColumnBaseTyped<T>::remove(BitmapPtr tids){
+		if(!tids) return false;
+		return this->remove(tids->toPositionList());
+}
+
+template<class T>
+const BitmapPtr ColumnBaseTyped<T>::bitmap_selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		//number of rows evaluated per call of the filter
+		const size_t BATCH_SIZE = 4096;
+		const size_t number_of_rows = this->size();
+		ColumnFilterPtr filter = this->createFilter(value_for_comparison,comp);
+		BitmapPtr bitmap( new Bitmap(number_of_rows));
+		std::vector<TID> selection_vector(BATCH_SIZE);
+		for(TID begin=0;begin<number_of_rows;begin+=BATCH_SIZE){
+			TID end = std::min(begin+BATCH_SIZE,number_of_rows);
+			size_t number_of_matches = filter->filter(begin,end,selection_vector.data());
+			for(size_t i=0;i<number_of_matches;++i){
+				bitmap->set(selection_vector[i]);
+			}
+		}
+		return bitmap;
+}
+
+template<class T>
+const ColumnFilterPtr ColumnBaseTyped<T>::createFilter(const boost::any& value_for_comparison, const ValueComparator comp){
+		return ColumnFilterPtr(new ColumnFilterTyped<T>(*this,this->getPredicate(value_for_comparison,comp)));
+}
+
+template<class T>
+bool ColumnBaseTyped<T>::isSorted(SortOrder order) const throw(){
+		if(!statistics_.isCurrent(this->size())) return false;
+		return (order==ASCENDING) ? statistics_.isSortedAscending() : statistics_.isSortedDescending();
+}
+
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::getSortedTIDs(SortOrder order) const{
+		if((order!=ASCENDING && order!=DESCENDING) || !this->isSorted(order)) return PositionListPtr();
+		PositionListPtr tids( new PositionList(this->size()));
+		for(TID i=0;i<tids->size();i++){
+			(*tids)[i]=i;
+		}
+		return tids;
+}
+
+template<class T>
+template<typename Predicate>
+TID ColumnBaseTyped<T>::partitionPoint(Predicate is_before){
+		TID begin=0;
+		TID end=this->size();
+		while(begin<end){
+			TID middle = begin+(end-begin)/2;
+			if(is_before((*this)[middle])){
+				begin=middle+1;
+			}else{
+				end=middle;
+			}
+		}
+		return begin;
+}
+
+template<class T>
+bool ColumnBaseTyped<T>::keepsOrder(TID tid, const T& value){
+		if(tid>=this->size()) return false;
+		//a NaN cannot be ordered between its neighbors
+		if(is_unordered(value,value)) return false;
+		if(tid>0 && tid+1<this->size()){
+			const T& previous = (*this)[tid-1];
+			const T& next = (*this)[tid+1];
+			const T& smaller = (next<previous) ? next : previous;
+			const T& larger = (next<previous) ? previous : next;
+			return !(value<smaller) && !(larger<value);
+		}
+		//the first or last row keeps the order only if it keeps its relation to its single neighbor
+		if(this->size()==1) return true;
+		const T& current = (*this)[tid];
+		const T& neighbor = (*this)[tid==0 ? 1 : tid-1];
+		return (current<neighbor)==(value<neighbor) && (neighbor<current)==(neighbor<value);
+}
+
+template<class T>
+bool ColumnBaseTyped<T>::findSortedRange(const ValuePredicate<T>& predicate, TID& begin, TID& end){
+		const ValueComparator comp = predicate.getValueComparator();
+		if(comp!=EQUAL && comp!=LESSER && comp!=LESSER_EQUAL && comp!=GREATER && comp!=GREATER_EQUAL && comp!=BETWEEN) return false;
+		const bool ascending = this->isSorted(ASCENDING);
+		if(!ascending && !this->isSorted(DESCENDING)) return false;
+
+		const T& value = predicate.getValue();
+		//lower is the value with the smaller rows in an ascending column and upper the value with the larger rows, a descending column swaps them
+		const T& lower = (comp==BETWEEN && !ascending) ? predicate.getUpperBound() : value;
+		const T& upper = (comp==BETWEEN && ascending) ? predicate.getUpperBound() : value;
+		//first row that is not strictly before lower, and first row that is strictly after upper w.r.t. the order of the column
+		TID lower_bound, upper_bound;
+		if(ascending){
+			lower_bound = partitionPoint([&lower](const T& x){ return x<lower; });
+			upper_bound = partitionPoint([&upper](const T& x){ return !(upper<x); });
+		}else{
+			lower_bound = partitionPoint([&lower](const T& x){ return lower<x; });
+			upper_bound = partitionPoint([&upper](const T& x){ return !(x<upper); });
+		}
+		const TID number_of_rows = this->size();
+		//in a descending column, the rows of values lesser than value are at the end
+		const bool lesser_at_begin = ascending;
+		switch(comp){
+			case EQUAL: begin=lower_bound; end=upper_bound; break;
+			case BETWEEN: begin=lower_bound; end=std::max(lower_bound,upper_bound); break;
+			case LESSER:
+				if(lesser_at_begin){ begin=0; end=lower_bound; }else{ begin=upper_bound; end=number_of_rows; }
+				break;
+			case LESSER_EQUAL:
+				if(lesser_at_begin){ begin=0; end=upper_bound; }else{ begin=lower_bound; end=number_of_rows; }
+				break;
+			case GREATER:
+				if(lesser_at_begin){ begin=upper_bound; end=number_of_rows; }else{ begin=0; end=lower_bound; }
+				break;
+			case GREATER_EQUAL:
+				if(lesser_at_begin){ begin=lower_bound; end=number_of_rows; }else{ begin=0; end=upper_bound; }
+				break;
+			case NOT_EQUAL:
+			case IN:
+			case BLOOM_FILTER: return false;
+		}
+		return true;
+}
+
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+
+		PositionListPtr result_tids = this->indexSelection(predicate);
+		if(result_tids) return result_tids;
+
+		result_tids = PositionListPtr(new PositionList());
+
+		if(!quiet) std::cout << "Using CPU for Selection..." << std::endl;
+		for(TID i=0;i<this->size();i++){
+			if(predicate((*this)[i])){
+				result_tids->push_back(i);
+			}
+		}
+
 	    return result_tids;
 }
 
-	
+	template<class T>
+	const boost::any ColumnBaseTyped<T>::aggregate(AggregationMethod method){
+		AggregationState<T> state;
+		this->aggregateAll(state);
+		return state.getResult(method);
+	}
+
+	template<class T>
+	const boost::any ColumnBaseTyped<T>::aggregate(AggregationMethod method, PositionListPtr tids){
+		AggregationState<T> state;
+		if(tids) this->aggregatePositions(*tids,state);
+		return state.getResult(method);
+	}
+
+	template<class T>
+	const boost::any ColumnBaseTyped<T>::aggregate(AggregationMethod method, BitmapPtr tids){
+		AggregationState<T> state;
+		if(!tids) return state.getResult(method);
+		if(tids->size()!=this->size()){
+			std::cout << "Fatal Error!!! Bitmap size does not match size of column " << this->name_ << std::endl;
+			return boost::any();
+		}
+		this->aggregateBitmap(*tids,state);
+		return state.getResult(method);
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::aggregateAll(AggregationState<T>& state){
+		for(TID i=0;i<this->size();i++){
+			state.add((*this)[i]);
+		}
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::aggregatePositions(const PositionList& tids, AggregationState<T>& state){
+		for(size_t i=0;i<tids.size();i++){
+			state.add((*this)[tids[i]]);
+		}
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::aggregateBitmap(const Bitmap& tids, AggregationState<T>& state){
+		const std::vector<uint64_t>& words = tids.getWords();
+		for(size_t i=0;i<words.size();i++){
+			uint64_t word = words[i];
+			while(word){
+				state.add((*this)[i*64+__builtin_ctzll(word)]);
+				word &= word-1;
+			}
+		}
+	}
+
+	template<class T>
+	const std::vector<int>* ColumnBaseTyped<T>::getDictionaryCodes() const{
+		return NULL;
+	}
+
+	template<class T>
+	const std::vector<T>* ColumnBaseTyped<T>::getDictionary() const{
+		return NULL;
+	}
+
+	template<class T>
+	const ColumnPairPtr ColumnBaseTyped<T>::aggregate_by_keys(ColumnPtr key_column, AggregationMethod method, GroupByAlgorithm algorithm){
+		if(!key_column) return ColumnPairPtr();
+		if(key_column->type()==typeid(int)){
+			return group_by(*shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<int> >(key_column),*this,method,algorithm);
+		}else if(key_column->type()==typeid(float)){
+			return group_by(*shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<float> >(key_column),*this,method,algorithm);
+		}else if(key_column->type()==typeid(std::string)){
+			return group_by(*shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<std::string> >(key_column),*this,method,algorithm);
+		}
+		std::cout << "Fatal Error!!! Unsupported key type of column " << key_column->getName() << std::endl;
+		return ColumnPairPtr();
+	}
+
+	template<class T>
+	const PositionListPairPtr ColumnBaseTyped<T>::join(ColumnPtr join_column_, JoinAlgorithm algorithm){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		ColumnBaseTyped<T>& join_column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_);
+		const JoinPlan plan = plan_join(*this,join_column,algorithm);
+		switch(plan.algorithm){
+			case NESTED_LOOP_JOIN: return this->nested_loop_join(join_column_);
+			case SORT_MERGE_JOIN: return merge_join(*this,join_column);
+			case HASH_JOIN:
+			case AUTO_JOIN: break;
+		}
+		//the hash index of the build side replaces the hash table, so only the probe side is decoded
+		std::vector<T> left_keys;
+		std::vector<T> right_keys;
+		if(plan.build_left && has_hash_index_){
+			decode_values(join_column,right_keys);
+			return parallel_hash_probe(this->getHashIndex(),this->size(),right_keys,plan.number_of_threads,plan.estimated_result_size);
+		}
+		decode_values(*this,left_keys);
+		PositionListPairPtr join_tids;
+		if(!plan.build_left && join_column.has_hash_index_){
+			join_tids = parallel_hash_probe(join_column.getHashIndex(),join_column.size(),left_keys,plan.number_of_threads,plan.estimated_result_size);
+			std::swap(join_tids->first,join_tids->second);
+			return join_tids;
+		}
+		decode_values(join_column,right_keys);
+		if(plan.build_left) return parallel_hash_join(left_keys,right_keys,plan.number_of_threads,plan.estimated_result_size);
+		join_tids = parallel_hash_join(right_keys,left_keys,plan.number_of_threads,plan.estimated_result_size);
+		std::swap(join_tids->first,join_tids->second);
+		return join_tids;
+	}
+
 	template<class T>
 	const PositionListPairPtr ColumnBaseTyped<T>::hash_join(ColumnPtr join_column_){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		ColumnBaseTyped<T>& join_column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_);
+		std::vector<T> build_keys;
+		std::vector<T> probe_keys;
+		decode_values(join_column,probe_keys);
+		if(has_hash_index_) return parallel_hash_probe(this->getHashIndex(),this->size(),probe_keys,getNumberOfThreads(probe_keys.size()),probe_keys.size());
+		decode_values(*this,build_keys);
+		return parallel_hash_join(build_keys,probe_keys,getNumberOfThreads(probe_keys.size()),probe_keys.size());
+	}
 
-		typedef boost::unordered_multimap<T,TID,boost::hash<T>, std::equal_to<T> > HashTable;
+	template<class T>
+	const ColumnProbePtr ColumnBaseTyped<T>::createProbe(ColumnPtr probe_column_){
+		if(!probe_column_ || probe_column_->type()!=typeid(T)){
+			std::cout << "Error! Cannot probe column " << this->name_ << " with column " << (probe_column_ ? probe_column_->getName() : std::string("NULL")) << std::endl;
+			return ColumnProbePtr();
+		}
+		ColumnBaseTyped<T>& probe_column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(probe_column_);
+		if(has_hash_index_) return ColumnProbePtr(new ColumnProbeTyped<T,HashIndex<T> >(this->getHashIndex(),probe_column));
+		return ColumnProbePtr(new JoinHashTableProbe<T>(*this,probe_column));
+	}
 
-				if(join_column_->type()!=typeid(T)){
-					std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
-					std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
-					exit(-1);
+	template<class T>
+	const PositionListPairPtr ColumnBaseTyped<T>::hash_join(ColumnPtr join_column_, BitmapPtr build_filter, BitmapPtr probe_filter){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		ColumnBaseTyped<T>& join_column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_);
+		if((build_filter && build_filter->size()!=this->size()) || (probe_filter && probe_filter->size()!=join_column.size())){
+			std::cout << "Fatal Error!!! Bitmap size does not match size of columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		//only the selected rows are decoded, hashed and probed, the hash index covers all rows, so it replaces the hash table only without a build filter
+		std::vector<T> build_keys;
+		std::vector<T> probe_keys;
+		decode_values(join_column,probe_filter,probe_keys);
+		const unsigned int number_of_threads = getNumberOfThreads(probe_keys.size());
+		PositionListPairPtr join_tids;
+		if(!build_filter && has_hash_index_){
+			join_tids = parallel_hash_probe(this->getHashIndex(),this->size(),probe_keys,number_of_threads,probe_keys.size());
+		}else{
+			decode_values(*this,build_filter,build_keys);
+			join_tids = parallel_hash_join(build_keys,probe_keys,number_of_threads,probe_keys.size());
+		}
+		if(build_filter) positions_to_tids(*join_tids->first,*build_filter);
+		if(probe_filter) positions_to_tids(*join_tids->second,*probe_filter);
+		return join_tids;
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::getDistinctValues(std::vector<T>& values){
+		ColumnPtr materialized_column = this->gather(BitmapPtr(new Bitmap(this->size(),true)));
+		ColumnBaseTyped<T>& column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(materialized_column);
+		values.reserve(values.size()+column.size());
+		for(unsigned int i=0;i<column.size();i++){
+			values.push_back(column[i]);
+		}
+	}
+
+	template<class T>
+	const std::vector<T> ColumnBaseTyped<T>::getJoinKeys(ColumnPtr join_column_){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > join_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_);
+		std::vector<T> keys;
+		join_column->getDistinctValues(keys);
+		std::sort(keys.begin(),keys.end());
+		keys.erase(std::unique(keys.begin(),keys.end()),keys.end());
+		return keys;
+	}
+
+	template<class T>
+	const TypedColumnStatistics<T>& ColumnBaseTyped<T>::getColumnStatistics(){
+		//columns that are modified without updating their statistics (e.g., a LookupArray) are detected by their size
+		if(statistics_.needsRebuild() || statistics_.getNumberOfRows()!=this->size()){
+			std::vector<T> values;
+			if(this->size()>0){
+				ColumnPtr materialized_column = this->gather(BitmapPtr(new Bitmap(this->size(),true)));
+				ColumnBaseTyped<T>& column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(materialized_column);
+				values.reserve(column.size());
+				for(unsigned int i=0;i<column.size();i++){
+					values.push_back(column[i]);
 				}
-				
-				shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > join_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_); //static_cast<IntColumnPtr>(column1);
+			}
+			statistics_.rebuild(values);
+		}
+		return statistics_;
+	}
 
-				PositionListPairPtr join_tids( new PositionListPair());
-				join_tids->first = PositionListPtr( new PositionList() );
-				join_tids->second = PositionListPtr( new PositionList() );
+	template<class T>
+	void ColumnBaseTyped<T>::createSortedIndex(){
+		has_sorted_index_=true;
+		sorted_index_.invalidate();
+	}
 
+	template<class T>
+	void ColumnBaseTyped<T>::dropSortedIndex(){
+		has_sorted_index_=false;
+		sorted_index_.clear();
+	}
+
+	template<class T>
+	bool ColumnBaseTyped<T>::hasSortedIndex() const throw(){
+		return has_sorted_index_;
+	}
 
-	//create hash table
-	HashTable hashtable;
-	for(unsigned int i=0;i<this->size();i++)	
-		hashtable.insert(
-								std::pair<T,TID> ((*this)[i],i)
-					);
-
-	//probe larger relation
-	for(unsigned int i=0;i<join_column->size();i++){
-		std::pair<typename HashTable::iterator, typename HashTable::iterator> range =  hashtable.equal_range((*join_column)[i]);
-		for(typename HashTable::iterator it=range.first ; it!=range.second;it++){
-			if(it->first==(*join_column)[i]){
-				join_tids->first->push_back(it->second);
-				join_tids->second->push_back(i);
-				//cout << "match! " << it->second << ", " << i << "	"  << it->first << endl;
+	template<class T>
+	void ColumnBaseTyped<T>::createHashIndex(){
+		has_hash_index_=true;
+		hash_index_.invalidate();
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::dropHashIndex(){
+		has_hash_index_=false;
+		hash_index_.clear();
+	}
+
+	template<class T>
+	bool ColumnBaseTyped<T>::hasHashIndex() const throw(){
+		return has_hash_index_;
+	}
+
+	template<class T>
+	const PositionListPtr ColumnBaseTyped<T>::index_scan(const boost::any& value_for_comparison, const ValueComparator comp){
+		if(!has_sorted_index_) return PositionListPtr();
+		return this->getSortedIndex().lookup(this->getPredicate(value_for_comparison,comp));
+	}
+
+	template<class T>
+	const SortedIndex<T>& ColumnBaseTyped<T>::getSortedIndex(){
+		//columns that are modified without maintaining the index (e.g., a LookupArray) are detected by their size
+		if(!sorted_index_.isValid() || sorted_index_.size()!=this->size()){
+			std::vector<T> values;
+			decode_values(*this,values);
+			sorted_index_.build(values,*this->sort(ASCENDING));
+		}
+		return sorted_index_;
+	}
+
+	template<class T>
+	const HashIndex<T>& ColumnBaseTyped<T>::getHashIndex(){
+		if(!hash_index_.isValid() || hash_index_.size()!=this->size()){
+			std::vector<T> values;
+			decode_values(*this,values);
+			hash_index_.build(values);
+		}
+		return hash_index_;
+	}
+
+	template<class T>
+	const PositionListPtr ColumnBaseTyped<T>::indexSelection(const ValuePredicate<T>& predicate){
+		const ValueComparator comp = predicate.getValueComparator();
+		const bool use_hash_index = has_hash_index_ && (comp==EQUAL || comp==IN);
+		const bool use_sorted_index = has_sorted_index_ && comp!=NOT_EQUAL && comp!=BLOOM_FILTER;
+		if(!use_hash_index && !use_sorted_index) return PositionListPtr();
+		if(this->getColumnStatistics().estimateSelectivity(predicate)>INDEX_SCAN_MAX_SELECTIVITY) return PositionListPtr();
+		if(use_hash_index){
+			if(!quiet) std::cout << "Using hash index of column " << this->name_ << " for Selection..." << std::endl;
+			return this->getHashIndex().lookup(predicate);
+		}
+		if(!quiet) std::cout << "Using sorted index of column " << this->name_ << " for Selection..." << std::endl;
+		return this->getSortedIndex().lookup(predicate);
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::indexInsert(const T& value){
+		//a current index has one entry per row, so the appended row has the number of entries as TID
+		if(has_sorted_index_ && sorted_index_.isValid()) sorted_index_.insert(value,TID(sorted_index_.size()));
+		if(has_hash_index_ && hash_index_.isValid()) hash_index_.insert(value);
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::indexUpdate(TID tid, const T& old_value, const T& new_value){
+		if(has_hash_index_ && hash_index_.isValid()) hash_index_.update(tid,new_value);
+		if(!has_sorted_index_ || !sorted_index_.isValid()) return;
+		if(!sorted_index_.remove(old_value,tid)){
+			sorted_index_.invalidate();
+			return;
+		}
+		sorted_index_.insert(new_value,tid);
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::indexRemove(TID tid, const T& old_value){
+		//all following rows change their TID, which are scattered over the chains of the hash index
+		hash_index_.invalidate();
+		if(!has_sorted_index_ || !sorted_index_.isValid()) return;
+		if(!sorted_index_.remove(old_value,tid)){
+			sorted_index_.invalidate();
+			return;
+		}
+		sorted_index_.shiftTIDs(tid);
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::invalidateIndex() throw(){
+		sorted_index_.invalidate();
+		hash_index_.invalidate();
+	}
+
+	template<class T>
+	const boost::any ColumnBaseTyped<T>::createBloomFilter(BitmapPtr filter){
+		if(filter && filter->size()!=this->size()) return boost::any();
+		std::vector<T> keys;
+		if(filter){
+			ColumnPtr selected_column = this->gather(filter);
+			ColumnBaseTyped<T>& column = *shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(selected_column);
+			keys.reserve(column.size());
+			for(unsigned int i=0;i<column.size();i++){
+				keys.push_back(column[i]);
 			}
+		}else{
+			this->getDistinctValues(keys);
 		}
+		shared_pointer_namespace::shared_ptr<BloomFilter<T> > bloom_filter(new BloomFilter<T>(keys.size()));
+		for(unsigned int i=0;i<keys.size();i++){
+			bloom_filter->insert(keys[i]);
+		}
+		return boost::any(bloom_filter);
 	}
 
-		return join_tids;
+	template<class T>
+	const PositionListPtr ColumnBaseTyped<T>::semi_join(ColumnPtr join_column_){
+		return this->selection(this->getJoinKeys(join_column_),IN);
+	}
+
+	template<class T>
+	const PositionListPtr ColumnBaseTyped<T>::anti_join(ColumnPtr join_column_){
+		BitmapPtr matches = this->bitmap_selection(this->getJoinKeys(join_column_),IN);
+		return matches->flip().toPositionList();
 	}
 
 	template<class Type>
@@ -247,11 +934,7 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 				
 				shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > join_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(join_column_); //static_cast<IntColumnPtr>(column1);
 
-				PositionListPairPtr join_tids( new PositionListPair());
-				join_tids->first = PositionListPtr( new PositionList() );
-				join_tids->second = PositionListPtr( new PositionList() );
-
-				return join_tids;
+				return merge_join(*this,*join_column);
 	}
 
 
@@ -294,17 +977,106 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 	  return true;
    }
 
+	template<class Type>
+	bool ColumnBaseTyped<Type>::applyConstantOperation(ColumnAlgebraOperation op, const Type& value){
+		if(!is_valid_operand(op,value)) return false;
+		//the operation changes the order and the range of the values
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		for(unsigned int i=0;i<this->size();i++){
+			apply_operation(this->operator[](i),op,value);
+		}
+		return true;
+	}
+
+	template<class Type>
+	bool ColumnBaseTyped<Type>::applyColumnOperation(ColumnAlgebraOperation op, ColumnBaseTyped<Type>& column){
+		//compressed columns may share one stored value between several rows, so the values are decoded,
+		//combined and inserted again instead of being modified with operator[]
+		std::vector<Type> values(this->size());
+		std::vector<Type> operands(this->size());
+		for(unsigned int i=0;i<values.size();i++){
+			values[i]=this->operator[](i);
+			operands[i]=column[i];
+		}
+		//check all operands first, so that the column is not modified partially
+		if(!is_valid_operand_array(op,operands.data(),operands.size())) return false;
+		if(!apply_column_operation(values.data(),values.data(),operands.data(),values.size(),op)) return false;
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		this->clearContent();
+		for(unsigned int i=0;i<values.size();i++){
+			this->insert(values[i]);
+		}
+		return true;
+	}
+
+	template<class Type>
+	const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > ColumnBaseTyped<Type>::getOperandColumn(ColumnPtr column) const{
+		if(!column || column->type()!=typeid(Type) || column->size()!=this->size()){
+			return shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> >();
+		}
+		return shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
+	}
+
+	template<class Type>
+	const ColumnPtr ColumnBaseTyped<Type>::gather(PositionListPtr tids){
+		if(!tids || !is_valid_position_list(*tids,this->size())) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > result = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(createColumn(this->db_type_,this->name_));
+		for(unsigned int i=0;i<tids->size();i++){
+			result->insert(this->operator[]((*tids)[i]));
+		}
+		return result;
+	}
+
+	template<class Type>
+	const ColumnPtr ColumnBaseTyped<Type>::gather(BitmapPtr tids){
+		if(!tids || tids->size()!=this->size()) return ColumnPtr();
+		return this->gather(tids->toPositionList());
+	}
+
+	template<class Type>
+	void ColumnBaseTyped<Type>::gatherValues(const TID* tids, size_t number_of_tids, Type* result){
+		ColumnPtr gathered = this->gather(PositionListPtr(new PositionList(tids,tids+number_of_tids)));
+		if(!gathered) return;
+		ColumnBaseTyped<Type>& values = static_cast<ColumnBaseTyped<Type>&>(*gathered);
+		for(size_t i=0;i<number_of_tids;i++){
+			result[i]=values[i];
+		}
+	}
+
+	template<class Type>
+	const shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > ColumnBaseTyped<Type>::materialize(){
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > result = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(createColumn(this->db_type_,this->name_));
+		for(unsigned int i=0;i<this->size();i++){
+			result->insert(this->operator[](i));
+		}
+		return result;
+	}
+
+	template<class Type>
+	const ColumnPtr ColumnBaseTyped<Type>::column_algebra_operation(const boost::any& value, ColumnAlgebraOperation op){
+		if(value.empty() || typeid(Type)!=value.type()) return ColumnPtr();
+		if(!is_valid_operand(op,boost::any_cast<Type>(value))) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > result = this->materialize();
+		if(!result->applyConstantOperation(op,boost::any_cast<Type>(value))) return ColumnPtr();
+		return result;
+	}
+
+	template<class Type>
+	const ColumnPtr ColumnBaseTyped<Type>::column_algebra_operation(ColumnPtr column, ColumnAlgebraOperation op){
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return ColumnPtr();
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > result = this->materialize();
+		if(!result->applyColumnOperation(op,*typed_column)) return ColumnPtr();
+		return result;
+	}
+
 	template<class Type>
 	bool ColumnBaseTyped<Type>::add(const boost::any& new_value){
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
-			 Type value = boost::any_cast<Type>(new_value);
-			 //std::transform(myvec.begin(), myvec.end(), myvec.begin(),
-          //bind2nd(std::plus<double>(), 1.0));
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)+=value;
-			 }
-			 return true;
+			return this->applyConstantOperation(ADD,boost::any_cast<Type>(new_value));
 		}
 		return false;
 	}
@@ -313,13 +1085,9 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 			
 	template<class Type>
 	bool ColumnBaseTyped<Type>::add(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)+=typed_column->operator[](i);
-		}			
-		return true;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return false;
+		return this->applyColumnOperation(ADD,*typed_column);
 	}
 
 
@@ -329,24 +1097,16 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 		//shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);	
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
-			 Type value = boost::any_cast<Type>(new_value);
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)-=value;
-			 }
-			 return true;
+			return this->applyConstantOperation(SUB,boost::any_cast<Type>(new_value));
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::minus(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)-=typed_column->operator[](i);
-		}			
-		return true;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return false;
+		return this->applyColumnOperation(SUB,*typed_column);
 	}	
 
 
@@ -354,24 +1114,16 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 	bool ColumnBaseTyped<Type>::multiply(const boost::any& new_value){
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
-			 Type value = boost::any_cast<Type>(new_value);
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)*=value;
-			 }
-			 return true;
+			return this->applyConstantOperation(MUL,boost::any_cast<Type>(new_value));
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::multiply(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)*=typed_column->operator[](i);
-		}			
-		return true;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return false;
+		return this->applyColumnOperation(MUL,*typed_column);
 	}
 
 
@@ -380,26 +1132,75 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 	bool ColumnBaseTyped<Type>::division(const boost::any& new_value){
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
-			 Type value = boost::any_cast<Type>(new_value);
-			 //check that we do not devide by zero
-			 if(value==0) return false;
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)/=value;
-			 }
-			 return true;
+			return this->applyConstantOperation(DIV,boost::any_cast<Type>(new_value));
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::division(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)/=typed_column->operator[](i);
-		}			
-		return true;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = this->getOperandColumn(column);
+		if(!typed_column) return false;
+		return this->applyColumnOperation(DIV,*typed_column);
+	}
+
+	//total template specializations, numeric columns are sorted with a radix sort
+	template<>
+	inline const PositionListPtr ColumnBaseTyped<int>::sort(SortOrder order){ PositionListPtr tids = this->getSortedTIDs(order); return tids ? tids : radix_sort(*this,order); }
+	template<>
+	inline const PositionListPtr ColumnBaseTyped<float>::sort(SortOrder order){ PositionListPtr tids = this->getSortedTIDs(order); return tids ? tids : radix_sort(*this,order); }
+
+	/*! \brief sorts a string column by radix sorting a normalized 8 byte prefix of each string
+	 *  \details the column is decoded once, only TIDs with equal prefixes are compared on the full strings*/
+	template<>
+	inline const PositionListPtr ColumnBaseTyped<std::string>::sort(SortOrder order){
+		typedef RadixKey<std::string>::KeyType KeyType;
+
+		if(order!=ASCENDING && order!=DESCENDING){
+			std::cout << "FATAL ERROR: ColumnBaseTyped<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr( new PositionList());
+		}
+		PositionListPtr sorted_tids = this->getSortedTIDs(order);
+		if(sorted_tids) return sorted_tids;
+
+		const size_t number_of_rows = this->size();
+		const KeyType mask = (order==ASCENDING) ? KeyType(0) : ~KeyType(0);
+		std::vector<std::string> values;
+		decode_values(*this,values);
+		std::vector<std::pair<KeyType,TID> > v(number_of_rows);
+		for(TID i=0;i<number_of_rows;i++){
+			v[i].first = RadixKey<std::string>::encode(values[i]) ^ mask;
+			v[i].second = i;
+		}
+
+		parallel_radix_sort_pairs(v,getNumberOfThreads(number_of_rows));
+
+		PositionListPtr ids = PositionListPtr( new PositionList(number_of_rows));
+		std::vector<std::pair<std::string,TID> > ties;
+		size_t begin=0;
+		while(begin<number_of_rows){
+			size_t end=begin+1;
+			while(end<number_of_rows && v[end].first==v[begin].first) ++end;
+			if(end-begin==1){
+				(*ids)[begin]=v[begin].second;
+			}else{
+				//equal prefixes, fall back to the full strings (the TIDs are still in ascending order)
+				ties.clear();
+				for(size_t i=begin;i<end;++i){
+					ties.push_back(std::pair<std::string,TID>(values[v[i].second],v[i].second));
+				}
+				if(order==ASCENDING){
+					std::stable_sort(ties.begin(),ties.end(),ValueLesser());
+				}else{
+					std::stable_sort(ties.begin(),ties.end(),ValueGreater());
+				}
+				for(size_t i=begin;i<end;++i){
+					(*ids)[i]=ties[i-begin].second;
+				}
+			}
+			begin=end;
+		}
+		return ids;
 	}
 
 	//total tempalte specializations, because numeric computations are undefined on strings 
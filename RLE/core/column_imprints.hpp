@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <stdint.h>
+#include <core/base_column.hpp>
+#include <core/predicate.hpp>
+
+namespace CoGaDB{
+
+/*! \brief size of the cache lines that are summarized by one imprint*/
+const size_t IMPRINTS_CACHE_LINE_SIZE = 64;
+/*! \brief largest number of value ranges (bins) of ColumnImprints, one bit of an imprint per bin*/
+const size_t IMPRINTS_NUMBER_OF_BINS = 64;
+/*! \brief number of values sampled to choose the borders of the bins*/
+const size_t IMPRINTS_SAMPLE_SIZE = 2048;
+
+/*!
+ *  \brief     ImprintsTraits<T>::supported is true for the types for which a Column builds ColumnImprints.
+ *  \details   Imprints pay off for numeric values, where a cache line holds many values, other types are scanned without them.
+ */
+template<typename T>
+struct ImprintsTraits{
+	static const bool supported = false;
+	static inline T lowest(){ return T(); }
+	static inline T highest(){ return T(); }
+};
+
+template<>
+struct ImprintsTraits<int>{
+	static const bool supported = true;
+	static inline int lowest(){ return std::numeric_limits<int>::min(); }
+	static inline int highest(){ return std::numeric_limits<int>::max(); }
+};
+
+/*! \brief the bounds are infinite, so that the first and the last bin include infinite values*/
+template<>
+struct ImprintsTraits<float>{
+	static const bool supported = true;
+	static inline float lowest(){ return -std::numeric_limits<float>::infinity(); }
+	static inline float highest(){ return std::numeric_limits<float>::infinity(); }
+};
+
+/*!
+ *  \brief     ColumnImprints store for each cache line of a value array a bit vector (imprint), which has bit b set if the cache line
+ *             contains a value of bin b, where the bins are value ranges chosen from a sample of the values.
+ *  \details   A range selection computes which bins may contain and which bins only contain matching values, and examines only the values
+ *             of cache lines whose imprint intersects the first set of bins. Cache lines whose imprint lies within the second set of bins match
+ *             entirely. In contrast to a ZoneMap, imprints also skip cache lines of unclustered columns, because the bins of the values of
+ *             a cache line rarely cover all bins. The bins are kept when values are appended or updated, so the imprints stay correct,
+ *             but the bins may become skewed. Removing rows shifts rows to other cache lines, so the owner has to invalidate the imprints,
+ *             which rebuilds them with the next call to rebuildIfOutdated.
+ */
+template<class T>
+class ColumnImprints{
+	public:
+	static const size_t VALUES_PER_CACHE_LINE = (sizeof(T)<IMPRINTS_CACHE_LINE_SIZE) ? IMPRINTS_CACHE_LINE_SIZE/sizeof(T) : 1;
+
+	ColumnImprints() : borders_(), imprints_(), number_of_rows_(0), valid_(false){}
+
+	/*! \brief adds a value appended to the array to the imprint of its cache line*/
+	inline void insert(const T& value){
+		if(!valid_) return;
+		if(number_of_rows_%VALUES_PER_CACHE_LINE==0) imprints_.push_back(0);
+		imprints_.back() |= uint64_t(1) << getBin(value);
+		number_of_rows_++;
+	}
+	/*! \brief adds the new value of row tid to the imprint of its cache line*/
+	inline void update(TID tid, const T& value){
+		if(!valid_ || tid>=number_of_rows_) return;
+		imprints_[tid/VALUES_PER_CACHE_LINE] |= uint64_t(1) << getBin(value);
+	}
+	void clear(){
+		borders_.clear();
+		imprints_.clear();
+		number_of_rows_=0;
+		valid_=false;
+	}
+	/*! \brief marks the imprints as outdated, e.g., after rows were removed or all values were modified*/
+	void invalidate() throw(){ valid_=false; }
+	/*! \brief chooses the bins from a sample of the values and computes the imprints, if they are outdated or the array was modified without updating them*/
+	void rebuildIfOutdated(const std::vector<T>& values);
+
+	/*! \brief computes the bins which may contain values matching the predicate and the bins which only contain values matching the predicate
+	 *  \return false if the imprints cannot skip cache lines for the predicate, because it may match values of all bins*/
+	bool getMasks(const ValuePredicate<T>& predicate, uint64_t& may_match_mask, uint64_t& full_match_mask) const;
+	inline uint64_t getImprint(size_t cache_line) const{ return imprints_[cache_line]; }
+
+	private:
+	/*! \brief bin 0 holds the values before the first border, bin b the values in [borders_[b-1],borders_[b])*/
+	inline size_t getBin(const T& value) const{
+		return std::upper_bound(borders_.begin(),borders_.end(),value)-borders_.begin();
+	}
+
+	/*! \brief ascending, distinct borders of the bins*/
+	std::vector<T> borders_;
+	std::vector<uint64_t> imprints_;
+	size_t number_of_rows_;
+	bool valid_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	const size_t ColumnImprints<T>::VALUES_PER_CACHE_LINE;
+
+	template<class T>
+	void ColumnImprints<T>::rebuildIfOutdated(const std::vector<T>& values){
+		if(valid_ && number_of_rows_==values.size()) return;
+		clear();
+		//equi-depth borders from an evenly spaced sample
+		std::vector<T> sample;
+		const size_t sample_size = std::min(values.size(),IMPRINTS_SAMPLE_SIZE);
+		sample.reserve(sample_size);
+		for(size_t i=0;i<sample_size;i++){
+			const T& value = values[(i*values.size())/sample_size];
+			//NaN is not ordered, it falls into the last bin
+			if(value==value) sample.push_back(value);
+		}
+		std::sort(sample.begin(),sample.end());
+		for(size_t b=1;b<IMPRINTS_NUMBER_OF_BINS && !sample.empty();b++){
+			const T& border = sample[(b*sample.size())/IMPRINTS_NUMBER_OF_BINS];
+			if(borders_.empty() || borders_.back()<border) borders_.push_back(border);
+		}
+		valid_=true;
+		imprints_.reserve((values.size()+VALUES_PER_CACHE_LINE-1)/VALUES_PER_CACHE_LINE);
+		for(size_t i=0;i<values.size();i++){
+			insert(values[i]);
+		}
+	}
+
+	template<class T>
+	bool ColumnImprints<T>::getMasks(const ValuePredicate<T>& predicate, uint64_t& may_match_mask, uint64_t& full_match_mask) const{
+		const ValueComparator comp = predicate.getValueComparator();
+		if(comp==NOT_EQUAL || comp==BLOOM_FILTER) return false;
+		//the first and the last bin are unbounded, so they never match entirely, which also keeps NaN and infinite values out of full matches
+		const T lowest = ImprintsTraits<T>::lowest();
+		const T highest = ImprintsTraits<T>::highest();
+		const size_t number_of_bins = borders_.size()+1;
+		may_match_mask=0;
+		full_match_mask=0;
+		for(size_t b=0;b<number_of_bins;b++){
+			const T& lower = (b==0) ? lowest : borders_[b-1];
+			const T& upper = (b+1==number_of_bins) ? highest : borders_[b];
+			if(predicate.mayMatchRange(lower,upper)) may_match_mask |= uint64_t(1) << b;
+			if(b>0 && b+1<number_of_bins && predicate.matchesRange(lower,upper)) full_match_mask |= uint64_t(1) << b;
+		}
+		const uint64_t all_bins = (number_of_bins==64) ? ~uint64_t(0) : (uint64_t(1) << number_of_bins)-1;
+		return may_match_mask!=all_bins || full_match_mask!=0;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of TIDs that share one base TID in the FRAME_OF_REFERENCE representation*/
+const size_t COMPACT_POSITION_LIST_BLOCK_SIZE = 64;
+
+/*!
+ *  \brief     A CompactPositionList is an immutable PositionList, which chooses the smallest of three representations when it is created.
+ *  \details   - RANGE: the TIDs form a range without gaps and are stored as first TID and size (constant space)
+ *             - FRAME_OF_REFERENCE: the TIDs are sorted and each block of COMPACT_POSITION_LIST_BLOCK_SIZE TIDs spans less than 2^16 rows,
+ *               so a TID is stored as 16 bit offset to the first TID of its block
+ *             - PLAIN: the TIDs are stored in a PositionList
+ *             All representations support random access in constant time. Since a CompactPositionList cannot be modified,
+ *             copies of a column share it instead of copying the TIDs.
+ */
+class CompactPositionList{
+	public:
+	enum Representation{RANGE,FRAME_OF_REFERENCE,PLAIN};
+
+	explicit CompactPositionList(const PositionList& tids);
+
+	size_t size() const throw(){ return size_; }
+	Representation getRepresentation() const throw(){ return representation_; }
+
+	inline TID operator[](size_t index) const{
+		switch(representation_){
+			case RANGE: return first_+TID(index);
+			case FRAME_OF_REFERENCE: return bases_[index/COMPACT_POSITION_LIST_BLOCK_SIZE]+offsets_[index];
+			case PLAIN: return tids_[index];
+		}
+		return tids_[index];
+	}
+
+	/*! \brief decodes the TIDs into a new PositionList*/
+	const PositionListPtr toPositionList() const;
+	/*! \brief returns the size in bytes the TIDs consume in main memory*/
+	size_t getSizeinBytes() const throw();
+
+	private:
+	Representation representation_;
+	size_t size_;
+	/*! \brief first TID of a RANGE*/
+	TID first_;
+	/*! \brief first TID of each block of a FRAME_OF_REFERENCE*/
+	std::vector<TID> bases_;
+	/*! \brief offset of each TID to the base of its block in a FRAME_OF_REFERENCE*/
+	std::vector<uint16_t> offsets_;
+	/*! \brief TIDs of the PLAIN representation*/
+	PositionList tids_;
+};
+
+/*! \brief defines a smart pointer to an immutable CompactPositionList, which can be shared between columns*/
+typedef shared_pointer_namespace::shared_ptr<const CompactPositionList> CompactPositionListPtr;
+
+}; //end namespace CogaDB
+
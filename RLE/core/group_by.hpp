@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <boost/unordered_map.hpp>
+#include <core/base_column.hpp>
+#include <core/aggregation.hpp>
+#include <core/gather.hpp>
+#include <core/parallel.hpp>
+
+namespace CoGaDB{
+
+template<class T>
+class ColumnBaseTyped; //forward declaration
+
+/*! \brief number of keys sampled to estimate the number of groups of a group by*/
+const size_t GROUP_BY_SAMPLE_SIZE = 1024;
+
+/*!
+ *  \brief     A GroupByResult collects the groups of a group by in a key column and an aggregate column.
+ *  \details   COUNT yields an INT column and AVG a FLOAT column, all other AggregationMethods yield a column of the type of the aggregated column.
+ *             The 64 bit sums and counts and the double sums and averages are narrowed to the type of the aggregate column. If an aggregate does not fit,
+ *             the result is invalid and get() returns a NULL pointer.
+ */
+template<class K, class T>
+class GroupByResult{
+	public:
+	GroupByResult(const ColumnBaseTyped<K>& keys, const ColumnBaseTyped<T>& values, AggregationMethod method)
+		: method_(method), keys_(createColumn(keys.getType(),keys.getName())), aggregates_(), overflow_(false){
+		AttributeType type = values.getType();
+		if(method==COUNT) type=INT;
+		if(method==AVG) type=FLOAT;
+		aggregates_=createColumn(type,values.getName());
+	}
+
+	void append(const K& key, const AggregationState<T>& state){
+		keys_->insert(boost::any(key));
+		const boost::any aggregate = state.getResult(method_);
+		//convert the aggregate to the type of the aggregate column
+		if(aggregate.type()==typeid(int64_t)){
+			const int64_t value = boost::any_cast<int64_t>(aggregate);
+			if(value<std::numeric_limits<int>::min() || value>std::numeric_limits<int>::max()) overflow_=true;
+			aggregates_->insert(boost::any(int(value)));
+		}else if(aggregate.type()==typeid(size_t)){
+			const size_t value = boost::any_cast<size_t>(aggregate);
+			if(value>size_t(std::numeric_limits<int>::max())) overflow_=true;
+			aggregates_->insert(boost::any(int(value)));
+		}else if(aggregate.type()==typeid(double)){
+			const double value = boost::any_cast<double>(aggregate);
+			if(std::fabs(value)>std::numeric_limits<float>::max() && !std::isinf(value)) overflow_=true;
+			aggregates_->insert(boost::any(float(value)));
+		}else{
+			aggregates_->insert(aggregate);
+		}
+	}
+
+	const ColumnPairPtr get() const{
+		if(overflow_){
+			std::cout << "Fatal Error!!! Aggregate of group by on column " << aggregates_->getName() << " does not fit into the aggregate column" << std::endl;
+			return ColumnPairPtr();
+		}
+		return ColumnPairPtr(new ColumnPair(keys_,aggregates_));
+	}
+
+	private:
+	AggregationMethod method_;
+	ColumnPtr keys_;
+	ColumnPtr aggregates_;
+	/*! \brief true if an aggregate does not fit into the aggregate column*/
+	bool overflow_;
+};
+
+/*! \brief returns true if the keys are in ascending order, stops at the first key that is smaller than its predecessor*/
+template<class K>
+bool is_sorted_ascending(const std::vector<K>& keys){
+	for(size_t i=1;i<keys.size();i++){
+		if(keys[i]<keys[i-1]) return false;
+	}
+	return true;
+}
+
+/*! \brief estimates the number of groups from the number of distinct keys in an evenly spaced sample
+ *  \details if most keys of the sample occur repeatedly, the sample has likely seen almost all groups, otherwise the number of distinct keys is extrapolated to the column*/
+template<class K>
+size_t estimate_number_of_groups(const std::vector<K>& keys){
+	const size_t number_of_rows = keys.size();
+	const size_t sample_size = std::min(number_of_rows,GROUP_BY_SAMPLE_SIZE);
+	if(sample_size==0) return 0;
+	std::vector<K> sample(sample_size);
+	for(size_t i=0;i<sample_size;i++){
+		sample[i]=keys[i*(number_of_rows/sample_size)];
+	}
+	std::sort(sample.begin(),sample.end());
+	size_t number_of_distinct_keys = std::unique(sample.begin(),sample.end())-sample.begin();
+	if(sample_size==number_of_rows || 2*number_of_distinct_keys<=sample_size) return number_of_distinct_keys;
+	return number_of_distinct_keys*(number_of_rows/sample_size);
+}
+
+/*! \brief groups the decoded key_values by hashing, every thread pre-aggregates its chunk in its own hash table, the tables are merged at the end
+ *  \details the order of the groups in the result is unspecified*/
+template<class K, class T>
+const ColumnPairPtr hash_group_by(const ColumnBaseTyped<K>& key_column, const std::vector<K>& keys, const ColumnBaseTyped<T>& value_column, const std::vector<T>& values, AggregationMethod method, unsigned int number_of_threads){
+	typedef boost::unordered_map<K,AggregationState<T>,boost::hash<K>,std::equal_to<K> > HashTable;
+
+	std::vector<HashTable> tables(std::max(number_of_threads,1u));
+	parallel_for_chunks(keys.size(),tables.size(),
+		[&keys,&values,&tables](unsigned int thread_id, size_t begin, size_t end){
+			HashTable& table = tables[thread_id];
+			for(TID i=begin;i<end;i++){
+				table[keys[i]].add(values[i]);
+			}
+		});
+	for(size_t i=1;i<tables.size();i++){
+		for(typename HashTable::const_iterator it=tables[i].begin();it!=tables[i].end();++it){
+			tables[0][it->first].merge(it->second);
+		}
+	}
+
+	GroupByResult<K,T> result(key_column,value_column,method);
+	for(typename HashTable::const_iterator it=tables[0].begin();it!=tables[0].end();++it){
+		result.append(it->first,it->second);
+	}
+	return result.get();
+}
+
+/*! \brief groups the decoded values by the codes of dictionary encoded keys, which are used as indices into an array of groups, every thread aggregates into its own array
+ *  \details codes that do not occur are skipped and codes with equal dictionary entries are merged into one group. 
+ *  The groups in the result are ordered by code.*/
+template<class K, class T>
+const ColumnPairPtr dictionary_group_by(const ColumnBaseTyped<K>& keys, const ColumnBaseTyped<T>& value_column, const std::vector<T>& values, AggregationMethod method, unsigned int number_of_threads){
+	typedef std::vector<AggregationState<T> > GroupArray;
+	const std::vector<int>& codes = *keys.getDictionaryCodes();
+	const std::vector<K>& dictionary = *keys.getDictionary();
+
+	//a thread does not necessarily process a morsel, so all arrays are sized before the merge reads them
+	std::vector<GroupArray> arrays(std::max(number_of_threads,1u),GroupArray(dictionary.size()));
+	parallel_for_chunks(codes.size(),arrays.size(),
+		[&codes,&values,&arrays](unsigned int thread_id, size_t begin, size_t end){
+			GroupArray& groups = arrays[thread_id];
+			for(TID i=begin;i<end;i++){
+				groups[codes[i]].add(values[i]);
+			}
+		});
+	GroupArray& groups = arrays[0];
+	for(size_t i=1;i<arrays.size();i++){
+		for(size_t code=0;code<arrays[i].size();code++){
+			groups[code].merge(arrays[i][code]);
+		}
+	}
+
+	boost::unordered_map<K,size_t,boost::hash<K>,std::equal_to<K> > code_of_key;
+	std::vector<size_t> group_codes;
+	for(size_t code=0;code<groups.size();code++){
+		if(groups[code].getCount()==0) continue;
+		std::pair<typename boost::unordered_map<K,size_t,boost::hash<K>,std::equal_to<K> >::iterator,bool> inserted = code_of_key.insert(std::make_pair(dictionary[code],code));
+		if(inserted.second){
+			group_codes.push_back(code);
+		}else{
+			groups[inserted.first->second].merge(groups[code]);
+		}
+	}
+
+	GroupByResult<K,T> result(keys,value_column,method);
+	for(size_t i=0;i<group_codes.size();i++){
+		result.append(dictionary[group_codes[i]],groups[group_codes[i]]);
+	}
+	return result.get();
+}
+
+/*! \brief groups the decoded key_values by visiting them in sorted order, so that each group is a run of equal keys
+ *  \details keys that are already sorted are not sorted again. The groups in the result are ordered ascending by key.*/
+template<class K, class T>
+const ColumnPairPtr sort_group_by(ColumnBaseTyped<K>& key_column, const std::vector<K>& keys, const ColumnBaseTyped<T>& value_column, const std::vector<T>& values, AggregationMethod method, bool keys_are_sorted){
+	GroupByResult<K,T> result(key_column,value_column,method);
+	const size_t number_of_rows = keys.size();
+	if(number_of_rows==0) return result.get();
+
+	PositionListPtr sorted_tids;
+	if(!keys_are_sorted) sorted_tids = key_column.sort(ASCENDING);
+
+	K current_key = keys[sorted_tids ? (*sorted_tids)[0] : 0];
+	AggregationState<T> state;
+	for(size_t i=0;i<number_of_rows;i++){
+		TID tid = sorted_tids ? (*sorted_tids)[i] : i;
+		K key = keys[tid];
+		if(!(key==current_key)){
+			result.append(current_key,state);
+			state=AggregationState<T>();
+			current_key=key;
+		}
+		state.add(values[tid]);
+	}
+	result.append(current_key,state);
+	return result.get();
+}
+
+/*! \brief groups the values by the keys and aggregates each group
+ *  \details dictionary compressed keys are grouped by their codes, unless the sort based algorithm is requested. Otherwise, AUTO_GROUP_BY uses the sort based algorithm for sorted keys and for keys with so many groups that the thread local hash tables 
+ *  would not reduce the data, and the hash based algorithm otherwise. The columns are decoded once with decode_values, because operator[] of compressed columns
+ *  is slow and not thread safe, so the algorithms work on plain vectors with several threads.
+ *  \return the key and the aggregate column, a NULL pointer if the columns have different sizes, the AggregationMethod is not supported or an aggregate does not fit into the aggregate column*/
+template<class K, class T>
+const ColumnPairPtr group_by(ColumnBaseTyped<K>& keys, ColumnBaseTyped<T>& values, AggregationMethod method, GroupByAlgorithm algorithm){
+	if(keys.size()!=values.size()){
+		std::cout << "Fatal Error!!! Group by on columns " << keys.getName() << " and " << values.getName() << " with different sizes" << std::endl;
+		return ColumnPairPtr();
+	}
+	if((method==SUM || method==AVG) && !AggregationTraits<T>::supports_sum){
+		std::cout << "Fatal Error!!! AggregationMethod " << method << " is not supported for column " << values.getName() << std::endl;
+		return ColumnPairPtr();
+	}
+
+	const unsigned int number_of_threads = getNumberOfThreads(keys.size());
+	std::vector<T> decoded_values;
+	decode_values(values,decoded_values);
+
+	//dictionary codes are dense indices, so hashing is not necessary
+	if(algorithm!=SORT_BASED_GROUP_BY && keys.getDictionaryCodes() && keys.getDictionary()){
+		if(!quiet) std::cout << "Using dictionary based Group By with " << number_of_threads << " threads..." << std::endl;
+		return dictionary_group_by(keys,values,decoded_values,method,number_of_threads);
+	}
+
+	std::vector<K> decoded_keys;
+	decode_values(keys,decoded_keys);
+	bool keys_are_sorted = false;
+	if(algorithm==AUTO_GROUP_BY){
+		keys_are_sorted = is_sorted_ascending(decoded_keys);
+		if(keys_are_sorted || 2*estimate_number_of_groups(decoded_keys)*number_of_threads > keys.size()){
+			algorithm=SORT_BASED_GROUP_BY;
+		}else{
+			algorithm=HASH_BASED_GROUP_BY;
+		}
+	}
+
+	if(algorithm==SORT_BASED_GROUP_BY){
+		if(!quiet) std::cout << "Using sort based Group By..." << std::endl;
+		return sort_group_by(keys,decoded_keys,values,decoded_values,method,keys_are_sorted);
+	}
+	if(!quiet) std::cout << "Using hash based Group By with " << number_of_threads << " threads..." << std::endl;
+	return hash_group_by(keys,decoded_keys,values,decoded_values,method,number_of_threads);
+}
+
+}; //end namespace CogaDB
+
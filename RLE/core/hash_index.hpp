@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <core/base_column.hpp>
+#include <core/hash_function.hpp>
+#include <core/predicate.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     A HashIndex is a chained hash table on the values of a column, which is kept with the column, so equality selections
+ *             look up their rows and hash joins probe it instead of building a JoinHashTable for every join.
+ *  \details   Like a JoinHashTable, the buckets store the TID of the first row of their chain and the chains are linked by TIDs.
+ *             In contrast to a JoinHashTable, the index keeps a copy of the values, so it can be maintained when rows are appended
+ *             or updated, and the chains are in no particular order. The number of buckets is doubled when the index holds more rows
+ *             than buckets. Removing rows changes the TIDs of all following rows, so the owner has to invalidate the index, which
+ *             is rebuilt before the next lookup. Probing does not modify the index, so several threads may probe it concurrently.
+ */
+template<class T>
+class HashIndex{
+	public:
+	HashIndex();
+
+	/*! \brief builds the index on the values of a column*/
+	void build(const std::vector<T>& values);
+	/*! \brief adds a value appended to the column, its TID is the number of rows of the index*/
+	void insert(const T& value);
+	/*! \brief moves row tid to the chain of its new value*/
+	void update(TID tid, const T& value);
+	void clear();
+	/*! \brief marks the index as outdated, e.g., after rows were removed, so the column rebuilds it before the next lookup*/
+	void invalidate() throw(){ valid_=false; }
+	bool isValid() const throw(){ return valid_; }
+	size_t size() const throw(){ return keys_.size(); }
+
+	/*! \brief calls function(tid) for each row with a value equal to key*/
+	template<typename Function>
+	inline void probe(const T& key, Function function) const{
+		if(buckets_.empty()) return;
+		for(TID tid=buckets_[compute_hash(key) & bucket_mask_];tid!=END_OF_CHAIN;tid=next_[tid]){
+			if(keys_[tid]==key) function(tid);
+		}
+	}
+	/*! \brief returns the TIDs of the rows matching an EQUAL or IN predicate in ascending order
+	 *  \return a NULL pointer for all other ValueComparators*/
+	const PositionListPtr lookup(const ValuePredicate<T>& predicate) const;
+
+	private:
+	static const TID END_OF_CHAIN = std::numeric_limits<TID>::max();
+	/*! \brief inserts row tid at the head of the chain of its value*/
+	inline void link(TID tid){
+		TID& bucket = buckets_[compute_hash(keys_[tid]) & bucket_mask_];
+		next_[tid]=bucket;
+		bucket=tid;
+	}
+	/*! \brief rehashes all rows into number_of_buckets buckets, which is a power of two*/
+	void rehash(size_t number_of_buckets);
+
+	std::vector<T> keys_;
+	std::vector<TID> buckets_;
+	std::vector<TID> next_;
+	/*! \brief number of buckets minus one*/
+	size_t bucket_mask_;
+	bool valid_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	const TID HashIndex<T>::END_OF_CHAIN;
+
+	template<class T>
+	HashIndex<T>::HashIndex() : keys_(), buckets_(), next_(), bucket_mask_(0), valid_(true){
+
+	}
+
+	template<class T>
+	void HashIndex<T>::clear(){
+		keys_.clear();
+		buckets_.clear();
+		next_.clear();
+		bucket_mask_=0;
+		valid_=true;
+	}
+
+	template<class T>
+	void HashIndex<T>::rehash(size_t number_of_buckets){
+		buckets_.assign(number_of_buckets,END_OF_CHAIN);
+		bucket_mask_=number_of_buckets-1;
+		next_.resize(keys_.size());
+		for(size_t i=0;i<keys_.size();i++){
+			link(TID(i));
+		}
+	}
+
+	template<class T>
+	void HashIndex<T>::build(const std::vector<T>& values){
+		keys_=values;
+		size_t number_of_buckets=1;
+		while(number_of_buckets<keys_.size()) number_of_buckets*=2;
+		rehash(number_of_buckets);
+		valid_=true;
+	}
+
+	template<class T>
+	void HashIndex<T>::insert(const T& value){
+		keys_.push_back(value);
+		next_.push_back(END_OF_CHAIN);
+		if(keys_.size()>buckets_.size()){
+			rehash(std::max<size_t>(1,2*buckets_.size()));
+		}else{
+			link(TID(keys_.size()-1));
+		}
+	}
+
+	template<class T>
+	void HashIndex<T>::update(TID tid, const T& value){
+		if(tid>=keys_.size()) return;
+		//unlink the row from the chain of its old value
+		TID* link_to_row = &buckets_[compute_hash(keys_[tid]) & bucket_mask_];
+		while(*link_to_row!=tid){
+			link_to_row = &next_[*link_to_row];
+		}
+		*link_to_row = next_[tid];
+		keys_[tid]=value;
+		link(tid);
+	}
+
+	template<class T>
+	const PositionListPtr HashIndex<T>::lookup(const ValuePredicate<T>& predicate) const{
+		PositionListPtr result_tids( new PositionList());
+		PositionList& result = *result_tids;
+		const ValueComparator comp = predicate.getValueComparator();
+		if(comp==EQUAL){
+			probe(predicate.getValue(),[&result](TID tid){ result.push_back(tid); });
+		}else if(comp==IN){
+			//the values of an IN predicate are distinct, so every row is found once
+			for(size_t i=0;i<predicate.getValues().size();i++){
+				probe(predicate.getValues()[i],[&result](TID tid){ result.push_back(tid); });
+			}
+		}else{
+			return PositionListPtr();
+		}
+		std::sort(result.begin(),result.end());
+		return result_tids;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <core/base_column.hpp>
+#include <core/bitmap.hpp>
+#include <core/column_statistics.hpp>
+#include <core/gather.hpp>
+#include <core/hash_function.hpp>
+#include <core/parallel.hpp>
+
+namespace CoGaDB{
+
+template<class T>
+class ColumnBaseTyped; //forward declaration
+
+/*! \brief largest number of value comparisons for which AUTO_JOIN uses the nested loop join, larger joins build a hash table*/
+const size_t NESTED_LOOP_JOIN_MAX_COMPARISONS = 1024;
+
+/*!
+ *  \brief     A JoinHashTable is a chained hash table on the keys of the build side of a hash join.
+ *  \details   The buckets store the TID of the first key of their chain and the chains are linked by TIDs, so the table consists of
+ *             two arrays of TIDs instead of one node per key. The chains are in ascending TID order. The keys are not copied,
+ *             so they must outlive the table. Probing does not modify the table, so several threads may probe it concurrently.
+ */
+template<class T>
+class JoinHashTable{
+	public:
+	explicit JoinHashTable(const std::vector<T>& keys);
+
+	/*! \brief calls function(tid) for each key equal to key in ascending TID order*/
+	template<typename Function>
+	inline void probe(const T& key, Function function) const{
+		for(TID tid=buckets_[compute_hash(key) & bucket_mask_];tid!=END_OF_CHAIN;tid=next_[tid]){
+			if(keys_[tid]==key) function(tid);
+		}
+	}
+
+	private:
+	static const TID END_OF_CHAIN = std::numeric_limits<TID>::max();
+	const std::vector<T>& keys_;
+	std::vector<TID> buckets_;
+	std::vector<TID> next_;
+	/*! \brief number of buckets minus one, the number of buckets is a power of two*/
+	size_t bucket_mask_;
+};
+
+/*!
+ *  \brief     A JoinPlan describes how a join of two columns is executed.
+ */
+struct JoinPlan{
+	JoinAlgorithm algorithm;
+	/*! \brief true if the hash table of a hash join is built on the left column*/
+	bool build_left;
+	unsigned int number_of_threads;
+	/*! \brief number of result rows estimated from the number of distinct values of both columns*/
+	size_t estimated_result_size;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	const TID JoinHashTable<T>::END_OF_CHAIN;
+
+	template<class T>
+	JoinHashTable<T>::JoinHashTable(const std::vector<T>& keys) : keys_(keys), buckets_(), next_(keys.size(),END_OF_CHAIN), bucket_mask_(0){
+		size_t number_of_buckets=1;
+		while(number_of_buckets<keys.size()) number_of_buckets*=2;
+		buckets_.resize(number_of_buckets,END_OF_CHAIN);
+		bucket_mask_=number_of_buckets-1;
+		//inserting in descending TID order at the head of the chains leaves the chains in ascending TID order
+		for(size_t i=keys.size();i>0;i--){
+			const TID tid = TID(i-1);
+			TID& bucket = buckets_[compute_hash(keys[tid]) & bucket_mask_];
+			next_[tid]=bucket;
+			bucket=tid;
+		}
+	}
+
+	/*! \brief chooses the algorithm, the build side and the number of threads of a join from the ColumnStatistics of both columns
+	 *  \details AUTO_JOIN uses the nested loop join for tiny inputs, where building a hash table costs more than comparing all pairs,
+	 *  the sort merge join if both columns are sorted ascending or descending, because the merge is a single linear pass, and the hash join otherwise.
+	 *  The hash table is built on the column with fewer rows, and the larger column is probed by several threads. A column with a HashIndex
+	 *  is preferred as build side, because its hash table already exists, and it makes the hash join preferable to the merge join.*/
+	template<class T>
+	const JoinPlan plan_join(ColumnBaseTyped<T>& left, ColumnBaseTyped<T>& right, JoinAlgorithm algorithm){
+		const ColumnStatistics& left_statistics = left.getColumnStatistics();
+		const ColumnStatistics& right_statistics = right.getColumnStatistics();
+		const double number_of_distinct_values = std::max(1.0,std::max(left_statistics.getNumberOfDistinctValues(),right_statistics.getNumberOfDistinctValues()));
+
+		JoinPlan plan;
+		plan.algorithm = algorithm;
+		plan.build_left = left.size()<=right.size();
+		if(left.hasHashIndex()!=right.hasHashIndex()) plan.build_left = left.hasHashIndex();
+		plan.number_of_threads = 1;
+		plan.estimated_result_size = static_cast<size_t>(double(left.size())*double(right.size())/number_of_distinct_values);
+		if(algorithm==AUTO_JOIN){
+			if(size_t(left.size())*right.size()<=NESTED_LOOP_JOIN_MAX_COMPARISONS){
+				plan.algorithm = NESTED_LOOP_JOIN;
+			}else if(!left.hasHashIndex() && !right.hasHashIndex()
+			         && (left_statistics.isSortedAscending() || left_statistics.isSortedDescending())
+			         && (right_statistics.isSortedAscending() || right_statistics.isSortedDescending())){
+				plan.algorithm = SORT_MERGE_JOIN;
+			}else{
+				plan.algorithm = HASH_JOIN;
+			}
+		}
+		if(plan.algorithm==HASH_JOIN){
+			plan.number_of_threads = getNumberOfThreads(plan.build_left ? right.size() : left.size());
+		}
+		if(!quiet){
+			std::cout << "Join " << left.getName() << " (" << left.size() << " rows, ~" << left_statistics.getNumberOfDistinctValues() << " distinct values"
+			          << (left_statistics.isSortedAscending() ? ", ascending" : "") << (left_statistics.isSortedDescending() ? ", descending" : "")
+			          << ") with " << right.getName() << " (" << right.size() << " rows, ~" << right_statistics.getNumberOfDistinctValues() << " distinct values"
+			          << (right_statistics.isSortedAscending() ? ", ascending" : "") << (right_statistics.isSortedDescending() ? ", descending" : "") << "): ";
+			if(plan.algorithm==HASH_JOIN){
+				std::cout << "Using hash join, build side " << (plan.build_left ? left.getName() : right.getName())
+				          << ((plan.build_left ? left.hasHashIndex() : right.hasHashIndex()) ? " (hash index)" : "")
+				          << ", with " << plan.number_of_threads << " threads";
+			}else if(plan.algorithm==SORT_MERGE_JOIN){
+				std::cout << "Using sort merge join";
+			}else{
+				std::cout << "Using nested loop join";
+			}
+			std::cout << ", estimated result size " << plan.estimated_result_size << std::endl;
+		}
+		return plan;
+	}
+
+	/*! \brief probes a hash table, e.g., a JoinHashTable or a HashIndex, with the keys of the probe side, whose morsels are probed by up to number_of_threads threads
+	 *  \return the TIDs of the build side in the first and the TIDs of the probe side in the second PositionList, ordered by the TIDs of the probe side*/
+	template<class T, class HashTable>
+	const PositionListPairPtr parallel_hash_probe(const HashTable& hash_table, size_t build_size, const std::vector<T>& probe_keys, unsigned int number_of_threads, size_t estimated_result_size){
+		const size_t number_of_morsels = std::max<size_t>(1,(probe_keys.size()+MORSEL_SIZE-1)/MORSEL_SIZE);
+		std::vector<PositionList> build_tids(number_of_morsels);
+		std::vector<PositionList> probe_tids(number_of_morsels);
+		//a wrong estimate must not allocate far more memory than the inputs
+		const double reserved_size_per_row = double(std::min(estimated_result_size,build_size+probe_keys.size()))/std::max<size_t>(1,probe_keys.size());
+		parallel_for_chunks(probe_keys.size(),number_of_threads,
+			[&](unsigned int, size_t begin, size_t end){
+				PositionList& build_result = build_tids[begin/MORSEL_SIZE];
+				PositionList& probe_result = probe_tids[begin/MORSEL_SIZE];
+				build_result.reserve(size_t(reserved_size_per_row*(end-begin)));
+				probe_result.reserve(size_t(reserved_size_per_row*(end-begin)));
+				for(size_t i=begin;i<end;i++){
+					const TID probe_tid = TID(i);
+					hash_table.probe(probe_keys[i],[&build_result,&probe_result,probe_tid](TID build_tid){
+						build_result.push_back(build_tid);
+						probe_result.push_back(probe_tid);
+					});
+				}
+			});
+
+		PositionListPairPtr join_tids( new PositionListPair());
+		join_tids->first = PositionListPtr( new PositionList() );
+		join_tids->second = PositionListPtr( new PositionList() );
+		size_t result_size=0;
+		for(size_t i=0;i<number_of_morsels;i++){
+			result_size+=build_tids[i].size();
+		}
+		join_tids->first->reserve(result_size);
+		join_tids->second->reserve(result_size);
+		for(size_t i=0;i<number_of_morsels;i++){
+			join_tids->first->insert(join_tids->first->end(),build_tids[i].begin(),build_tids[i].end());
+			join_tids->second->insert(join_tids->second->end(),probe_tids[i].begin(),probe_tids[i].end());
+		}
+		return join_tids;
+	}
+
+	/*! \brief replaces the positions of a join result, which index the rows selected by filter, by the TIDs of these rows*/
+	inline void positions_to_tids(PositionList& positions, const Bitmap& filter){
+		const PositionListPtr tids = filter.toPositionList();
+		for(size_t i=0;i<positions.size();i++){
+			positions[i]=(*tids)[positions[i]];
+		}
+	}
+
+	/*! \brief builds a JoinHashTable on the keys of the build side and probes it with the keys of the probe side using number_of_threads threads*/
+	template<class T>
+	const PositionListPairPtr parallel_hash_join(const std::vector<T>& build_keys, const std::vector<T>& probe_keys, unsigned int number_of_threads, size_t estimated_result_size){
+		const JoinHashTable<T> hash_table(build_keys);
+		return parallel_hash_probe(hash_table,build_keys.size(),probe_keys,number_of_threads,estimated_result_size);
+	}
+
+	/*! \brief returns the TIDs of the column in ascending order of their values, sorted columns are not sorted again
+	 *  \details equal values of a descending column are returned in descending TID order, which does not matter for a merge*/
+	template<class T>
+	const PositionListPtr get_sorted_tids(ColumnBaseTyped<T>& column){
+		const ColumnStatistics& statistics = column.getColumnStatistics();
+		if(!statistics.isSortedAscending() && !statistics.isSortedDescending()) return column.sort(ASCENDING);
+		const bool ascending = statistics.isSortedAscending();
+		PositionListPtr tids( new PositionList(column.size()));
+		for(unsigned int i=0;i<tids->size();i++){
+			(*tids)[i] = ascending ? i : TID(tids->size()-1-i);
+		}
+		return tids;
+	}
+
+	/*! \brief sorts both columns and merges them, each run of equal values of the left column is joined with the run of equal values of the right column
+	 *  \return the TIDs of the left column in the first and the TIDs of the right column in the second PositionList, ordered by value*/
+	template<class T>
+	const PositionListPairPtr merge_join(ColumnBaseTyped<T>& left, ColumnBaseTyped<T>& right){
+		std::vector<T> left_keys;
+		std::vector<T> right_keys;
+		decode_values(left,left_keys);
+		decode_values(right,right_keys);
+		PositionListPtr left_tids = get_sorted_tids(left);
+		PositionListPtr right_tids = get_sorted_tids(right);
+
+		PositionListPairPtr join_tids( new PositionListPair());
+		join_tids->first = PositionListPtr( new PositionList() );
+		join_tids->second = PositionListPtr( new PositionList() );
+		size_t l=0;
+		size_t r=0;
+		while(l<left_tids->size() && r<right_tids->size()){
+			const T& left_key = left_keys[(*left_tids)[l]];
+			const T& right_key = right_keys[(*right_tids)[r]];
+			if(left_key<right_key){
+				l++;
+			}else if(right_key<left_key){
+				r++;
+			}else{
+				size_t left_end=l+1;
+				while(left_end<left_tids->size() && left_keys[(*left_tids)[left_end]]==left_key) left_end++;
+				size_t right_end=r+1;
+				while(right_end<right_tids->size() && right_keys[(*right_tids)[right_end]]==right_key) right_end++;
+				for(size_t i=l;i<left_end;i++){
+					for(size_t j=r;j<right_end;j++){
+						join_tids->first->push_back((*left_tids)[i]);
+						join_tids->second->push_back((*right_tids)[j]);
+					}
+				}
+				l=left_end;
+				r=right_end;
+			}
+		}
+		return join_tids;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
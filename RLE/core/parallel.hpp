@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <core/base_column.hpp>
+#include <core/task_scheduler.hpp>
+
+namespace CoGaDB{
+
+/*! \brief minimal number of rows a thread should process, smaller inputs are processed by fewer threads*/
+const size_t MIN_ROWS_PER_THREAD = 64*1024;
+
+/*! \brief returns the number of threads that should process number_of_rows rows
+ *  \details uses all workers of the TaskScheduler for large inputs and a single thread for small inputs*/
+inline unsigned int getNumberOfThreads(size_t number_of_rows){
+	size_t threads = number_of_rows/MIN_ROWS_PER_THREAD;
+	if(threads<1) threads=1;
+	//the thread that submits a job takes part in it
+	const size_t available_threads = TaskScheduler::getInstance().getNumberOfWorkers()+1;
+	if(threads>available_threads) threads=available_threads;
+	return static_cast<unsigned int>(threads);
+}
+
+/*! \brief splits the range [0,number_of_rows) into morsels of morsel_size rows, which up to number_of_threads threads of the TaskScheduler process
+ *  \details function is called as function(thread_id,begin,end) for each morsel. All calls of a thread have the same thread_id in [0,number_of_threads),
+ *  so function may accumulate a result per thread, but the morsels of a thread are not necessarily adjacent. A single thread or a range
+ *  of a single morsel is processed in one call by the calling thread. The call returns after all morsels are processed.*/
+template<typename Function>
+void parallel_for_chunks(size_t number_of_rows, unsigned int number_of_threads, Function function, size_t morsel_size=MORSEL_SIZE){
+	if(number_of_threads<=1 || number_of_rows<=morsel_size){
+		function(0u,size_t(0),number_of_rows);
+		return;
+	}
+	TaskScheduler::getInstance().execute(number_of_rows,morsel_size,number_of_threads,function);
+}
+
+/*! \brief runs a scan over [0,number_of_rows) in parallel and concatenates the TIDs found by each morsel in TID order
+ *  \details function is called as function(begin,end,result) and appends the matching TIDs of its morsel to result*/
+template<typename Function>
+const PositionListPtr parallel_scan(size_t number_of_rows, unsigned int number_of_threads, Function function, size_t morsel_size=MORSEL_SIZE){
+	if(number_of_threads<=1 || number_of_rows<=morsel_size){
+		PositionListPtr result_tids( new PositionList());
+		function(size_t(0),number_of_rows,*result_tids);
+		return result_tids;
+	}
+	std::vector<PositionList> partial_results((number_of_rows+morsel_size-1)/morsel_size);
+	parallel_for_chunks(number_of_rows,number_of_threads,
+		[&partial_results,&function,morsel_size](unsigned int, size_t begin, size_t end){
+			function(begin,end,partial_results[begin/morsel_size]);
+		},morsel_size);
+	size_t result_size=0;
+	for(unsigned int i=0;i<partial_results.size();++i){
+		result_size+=partial_results[i].size();
+	}
+	PositionListPtr result_tids( new PositionList());
+	result_tids->reserve(result_size);
+	for(unsigned int i=0;i<partial_results.size();++i){
+		result_tids->insert(result_tids->end(),partial_results[i].begin(),partial_results[i].end());
+	}
+	return result_tids;
+}
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <boost/any.hpp>
+#include <core/global_definitions.hpp>
+#include <core/bloom_filter.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     A ValuePredicate is the typed form of a filter condition (value_for_comparison, ValueComparator) of a selection.
+ *  \details   The comparison value is stored in the boost::any as follows:
+ *             - LESSER, GREATER, EQUAL, LESSER_EQUAL, GREATER_EQUAL, NOT_EQUAL: a value of type T
+ *             - BETWEEN: a std::pair<T,T> with the inclusive lower and upper bound
+ *             - IN: a std::vector<T> with the set of values
+ *             - BLOOM_FILTER: a shared_ptr<BloomFilter<T> >, the predicate matches all keys of the filter and its false positives
+ *             Besides evaluating single values, a predicate can decide for a value range [min,max] whether no, some or all values match,
+ *             which compressed columns use to skip or accept whole runs and blocks.
+ */
+template<class T>
+class ValuePredicate{
+	public:
+	ValuePredicate(const boost::any& value_for_comparison, const ValueComparator comp);
+
+	/*! \brief returns false if the comparison value has the wrong type for the ValueComparator*/
+	bool isValid() const throw(){ return valid_; }
+	ValueComparator getValueComparator() const throw(){ return comp_; }
+	/*! \brief returns the comparison value, which is the lower bound for BETWEEN*/
+	const T& getValue() const throw(){ return value_; }
+	/*! \brief returns the upper bound for BETWEEN*/
+	const T& getUpperBound() const throw(){ return upper_; }
+	/*! \brief returns the sorted values without duplicates for IN*/
+	const std::vector<T>& getValues() const throw(){ return values_; }
+
+	/*! \brief evaluates the predicate on a single value*/
+	inline bool operator()(const T& x) const;
+	/*! \brief returns true if at least one value in [min,max] may match*/
+	bool mayMatchRange(const T& min, const T& max) const;
+	/*! \brief returns true if all values in [min,max] match*/
+	bool matchesRange(const T& min, const T& max) const;
+
+	/*! \brief calls function(matches) with a functor specialized for the ValueComparator, so scan loops do not branch on the comparator per row*/
+	template<typename Function>
+	void dispatch(Function function) const;
+
+	private:
+	struct EqualTo{ const T& v; inline bool operator()(const T& x) const { return x==v; } };
+	struct NotEqualTo{ const T& v; inline bool operator()(const T& x) const { return !(x==v); } };
+	struct Lesser{ const T& v; inline bool operator()(const T& x) const { return x<v; } };
+	struct LesserEqual{ const T& v; inline bool operator()(const T& x) const { return !(v<x); } };
+	struct Greater{ const T& v; inline bool operator()(const T& x) const { return v<x; } };
+	struct GreaterEqual{ const T& v; inline bool operator()(const T& x) const { return !(x<v); } };
+	struct Between{ const T& lower; const T& upper; inline bool operator()(const T& x) const { return !(x<lower) && !(upper<x); } };
+	struct InSet{ const std::vector<T>& values; inline bool operator()(const T& x) const { return std::binary_search(values.begin(),values.end(),x); } };
+	struct InBloomFilter{ const BloomFilter<T>& bloom_filter; inline bool operator()(const T& x) const { return bloom_filter.contains(x); } };
+
+	ValueComparator comp_;
+	bool valid_;
+	/*! \brief comparison value, lower bound for BETWEEN*/
+	T value_;
+	/*! \brief upper bound for BETWEEN*/
+	T upper_;
+	/*! \brief sorted set of values for IN*/
+	std::vector<T> values_;
+	/*! \brief filter for BLOOM_FILTER*/
+	shared_pointer_namespace::shared_ptr<BloomFilter<T> > bloom_filter_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	ValuePredicate<T>::ValuePredicate(const boost::any& value_for_comparison, const ValueComparator comp)
+		: comp_(comp), valid_(false), value_(), upper_(), values_(), bloom_filter_(){
+		if(comp==BETWEEN){
+			if(value_for_comparison.type()==typeid(std::pair<T,T>)){
+				std::pair<T,T> bounds = boost::any_cast<std::pair<T,T> >(value_for_comparison);
+				value_=bounds.first;
+				upper_=bounds.second;
+				valid_=true;
+			}
+		}else if(comp==IN){
+			if(value_for_comparison.type()==typeid(std::vector<T>)){
+				values_ = boost::any_cast<std::vector<T> >(value_for_comparison);
+				std::sort(values_.begin(),values_.end());
+				values_.erase(std::unique(values_.begin(),values_.end()),values_.end());
+				valid_=true;
+			}
+		}else if(comp==BLOOM_FILTER){
+			if(value_for_comparison.type()==typeid(shared_pointer_namespace::shared_ptr<BloomFilter<T> >)){
+				bloom_filter_ = boost::any_cast<shared_pointer_namespace::shared_ptr<BloomFilter<T> > >(value_for_comparison);
+				valid_=bloom_filter_.get()!=NULL;
+			}
+		}else if(value_for_comparison.type()==typeid(T)){
+			value_ = boost::any_cast<T>(value_for_comparison);
+			valid_=true;
+		}
+	}
+
+	template<class T>
+	inline bool ValuePredicate<T>::operator()(const T& x) const{
+		switch(comp_){
+			case EQUAL: return x==value_;
+			case NOT_EQUAL: return !(x==value_);
+			case LESSER: return x<value_;
+			case LESSER_EQUAL: return !(value_<x);
+			case GREATER: return value_<x;
+			case GREATER_EQUAL: return !(x<value_);
+			case BETWEEN: return !(x<value_) && !(upper_<x);
+			case IN: return std::binary_search(values_.begin(),values_.end(),x);
+			case BLOOM_FILTER: return bloom_filter_->contains(x);
+		}
+		return false;
+	}
+
+	template<class T>
+	bool ValuePredicate<T>::mayMatchRange(const T& min, const T& max) const{
+		switch(comp_){
+			case EQUAL: return !(value_<min) && !(max<value_);
+			case NOT_EQUAL: return !(min==value_ && max==value_);
+			case LESSER: return min<value_;
+			case LESSER_EQUAL: return !(value_<min);
+			case GREATER: return value_<max;
+			case GREATER_EQUAL: return !(max<value_);
+			case BETWEEN: return !(max<value_) && !(upper_<min);
+			case IN: {
+				typename std::vector<T>::const_iterator it = std::lower_bound(values_.begin(),values_.end(),min);
+				return it!=values_.end() && !(max<*it);
+			}
+			case BLOOM_FILTER: return bloom_filter_->mayContainRange(min,max);
+		}
+		return true;
+	}
+
+	template<class T>
+	bool ValuePredicate<T>::matchesRange(const T& min, const T& max) const{
+		switch(comp_){
+			case EQUAL: return min==value_ && max==value_;
+			case NOT_EQUAL: return value_<min || max<value_;
+			case LESSER: return max<value_;
+			case LESSER_EQUAL: return !(value_<max);
+			case GREATER: return value_<min;
+			case GREATER_EQUAL: return !(min<value_);
+			case BETWEEN: return !(min<value_) && !(upper_<max);
+			case IN: return min==max && std::binary_search(values_.begin(),values_.end(),min);
+			//a run or block cannot be accepted without checking its values, because the filter has false positives
+			case BLOOM_FILTER: return false;
+		}
+		return false;
+	}
+
+	template<class T>
+	template<typename Function>
+	void ValuePredicate<T>::dispatch(Function function) const{
+		switch(comp_){
+			case EQUAL: { EqualTo f = {value_}; function(f); break; }
+			case NOT_EQUAL: { NotEqualTo f = {value_}; function(f); break; }
+			case LESSER: { Lesser f = {value_}; function(f); break; }
+			case LESSER_EQUAL: { LesserEqual f = {value_}; function(f); break; }
+			case GREATER: { Greater f = {value_}; function(f); break; }
+			case GREATER_EQUAL: { GreaterEqual f = {value_}; function(f); break; }
+			case BETWEEN: { Between f = {value_,upper_}; function(f); break; }
+			case IN: { InSet f = {values_}; function(f); break; }
+			case BLOOM_FILTER: { InBloomFilter f = {*bloom_filter_}; function(f); break; }
+		}
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,262 @@
+
+#include <core/pipeline.hpp>
+#include <core/column_base_typed.hpp>
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace CoGaDB{
+
+	/*! \brief writes the TIDs of the rows [begin,end) to tids*/
+	static void scan_rows(TID begin, TID end, PositionList& tids){
+		tids.resize(end-begin);
+		for(TID i=begin;i<end;i++){
+			tids[i-begin]=i;
+		}
+	}
+
+	/*!
+	 *  \brief     A PipelineOperator processes the batches of a Pipeline.
+	 *  \details   A batch holds one array of TIDs per table, all arrays have the same length. An operator reads and modifies the arrays
+	 *             of the tables that were joined before it was added, a join also writes the array of its build table.
+	 */
+	class PipelineOperator{
+		public:
+		virtual ~PipelineOperator(){}
+		virtual Operation getOperation() const throw()=0;
+		/*! \brief processes a batch*/
+		virtual void push(std::vector<PositionList>& batch)=0;
+		/*! \brief processes the rows [begin,end) of the driving table, if the operator is the first operator of the pipeline*/
+		virtual void scan(TID begin, TID end, std::vector<PositionList>& batch){
+			scan_rows(begin,end,batch[0]);
+			push(batch);
+		}
+		/*! \brief discards the result of the previous execution*/
+		virtual void reset(){}
+		virtual const boost::any getResult() const{ return boost::any(); }
+	};
+
+	class SelectionOperator : public PipelineOperator{
+		public:
+		SelectionOperator(unsigned int table, unsigned int number_of_tables, ColumnPtr column, ColumnFilterPtr filter)
+			: table_(table), number_of_tables_(number_of_tables), column_(column), filter_(filter), matches_(){}
+
+		virtual Operation getOperation() const throw(){ return SELECTION; }
+
+		virtual void push(std::vector<PositionList>& batch){
+			PositionList& tids = batch[table_];
+			if(number_of_tables_==1){
+				tids.resize(filter_->filter(tids.data(),tids.size(),tids.data()));
+				return;
+			}
+			matches_.resize(tids.size());
+			const size_t number_of_matches = filter_->filter(tids.data(),tids.size(),matches_.data());
+			//the matches are a subsequence of the TIDs, and a TID that occurs several times matches either always or never
+			size_t number_of_rows=0;
+			for(size_t i=0;i<tids.size() && number_of_rows<number_of_matches;i++){
+				if(tids[i]!=matches_[number_of_rows]) continue;
+				for(unsigned int t=0;t<number_of_tables_;t++){
+					batch[t][number_of_rows]=batch[t][i];
+				}
+				number_of_rows++;
+			}
+			for(unsigned int t=0;t<number_of_tables_;t++){
+				batch[t].resize(number_of_rows);
+			}
+		}
+
+		virtual void scan(TID begin, TID end, std::vector<PositionList>& batch){
+			PositionList& tids = batch[0];
+			tids.resize(end-begin);
+			tids.resize(filter_->filter(begin,end,tids.data()));
+		}
+
+		private:
+		unsigned int table_;
+		/*! \brief number of tables joined before the selection*/
+		unsigned int number_of_tables_;
+		ColumnPtr column_;
+		ColumnFilterPtr filter_;
+		PositionList matches_;
+	};
+
+	class JoinOperator : public PipelineOperator{
+		public:
+		JoinOperator(unsigned int table, unsigned int build_table, ColumnPtr probe_column, ColumnPtr build_column, ColumnProbePtr probe)
+			: table_(table), build_table_(build_table), probe_column_(probe_column), build_column_(build_column), probe_(probe), positions_(), build_tids_(), tids_(){}
+
+		virtual Operation getOperation() const throw(){ return JOIN; }
+
+		virtual void push(std::vector<PositionList>& batch){
+			const PositionList& tids = batch[table_];
+			positions_.clear();
+			build_tids_.clear();
+			probe_->probe(tids.data(),tids.size(),positions_,build_tids_);
+			//each match repeats the row of the probe side, so the batch may grow
+			for(unsigned int t=0;t<build_table_;t++){
+				const PositionList& table_tids = batch[t];
+				tids_.resize(positions_.size());
+				for(size_t i=0;i<positions_.size();i++){
+					tids_[i]=table_tids[positions_[i]];
+				}
+				batch[t].swap(tids_);
+			}
+			batch[build_table_].swap(build_tids_);
+		}
+
+		private:
+		unsigned int table_;
+		unsigned int build_table_;
+		ColumnPtr probe_column_;
+		ColumnPtr build_column_;
+		ColumnProbePtr probe_;
+		PositionList positions_;
+		PositionList build_tids_;
+		PositionList tids_;
+	};
+
+	template<class T>
+	class AggregationOperator : public PipelineOperator{
+		public:
+		AggregationOperator(unsigned int table, ColumnPtr column, AggregationMethod method)
+			: table_(table), column_(column), typed_column_(static_cast<ColumnBaseTyped<T>&>(*column)), method_(method), state_(), values_(){}
+
+		virtual Operation getOperation() const throw(){ return AGGREGATION; }
+
+		virtual void push(std::vector<PositionList>& batch){
+			const PositionList& tids = batch[table_];
+			values_.resize(tids.size());
+			typed_column_.gatherValues(tids.data(),tids.size(),values_.data());
+			aggregate_values(values_.data(),values_.size(),state_);
+		}
+
+		virtual void reset(){
+			state_ = AggregationState<T>();
+		}
+
+		virtual const boost::any getResult() const{
+			return state_.getResult(method_);
+		}
+
+		private:
+		unsigned int table_;
+		ColumnPtr column_;
+		ColumnBaseTyped<T>& typed_column_;
+		AggregationMethod method_;
+		AggregationState<T> state_;
+		/*! \brief values of the current batch*/
+		std::vector<T> values_;
+	};
+
+	Pipeline::Pipeline(size_t number_of_rows) : operators_(), aggregations_(), table_sizes_(1,number_of_rows), results_(){
+
+	}
+
+	bool Pipeline::belongsToTable(unsigned int table, ColumnPtr column) const{
+		if(!column) return false;
+		if(table>=table_sizes_.size()){
+			cout << "Error! Pipeline: table " << table << " of column " << column->getName() << " does not exist" << endl;
+			return false;
+		}
+		if(column->size()!=table_sizes_[table]){
+			cout << "Error! Pipeline: column " << column->getName() << " has " << column->size()
+			     << " rows, but table " << table << " has " << table_sizes_[table] << " rows" << endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool Pipeline::addSelection(unsigned int table, ColumnPtr column, const boost::any& value_for_comparison, const ValueComparator comp){
+		if(!belongsToTable(table,column)) return false;
+		operators_.push_back(PipelineOperatorPtr(new SelectionOperator(table,getNumberOfTables(),column,column->createFilter(value_for_comparison,comp))));
+		return true;
+	}
+
+	bool Pipeline::addJoin(unsigned int table, ColumnPtr probe_column, ColumnPtr build_column){
+		if(!build_column || !belongsToTable(table,probe_column)) return false;
+		ColumnProbePtr probe = build_column->createProbe(probe_column);
+		if(!probe) return false;
+		operators_.push_back(PipelineOperatorPtr(new JoinOperator(table,getNumberOfTables(),probe_column,build_column,probe)));
+		table_sizes_.push_back(build_column->size());
+		return true;
+	}
+
+	bool Pipeline::addAggregation(unsigned int table, ColumnPtr column, AggregationMethod method){
+		if(!belongsToTable(table,column)) return false;
+		if(column->type()==typeid(int)){
+			aggregations_.push_back(PipelineOperatorPtr(new AggregationOperator<int>(table,column,method)));
+		}else if(column->type()==typeid(float)){
+			aggregations_.push_back(PipelineOperatorPtr(new AggregationOperator<float>(table,column,method)));
+		}else if(column->type()==typeid(std::string)){
+			aggregations_.push_back(PipelineOperatorPtr(new AggregationOperator<std::string>(table,column,method)));
+		}else{
+			cout << "Error! Pipeline: unsupported type of column " << column->getName() << endl;
+			return false;
+		}
+		return true;
+	}
+
+	void Pipeline::execute(){
+		results_.clear();
+		for(unsigned int i=0;i<aggregations_.size();i++){
+			aggregations_[i]->reset();
+		}
+		if(aggregations_.empty()){
+			for(unsigned int t=0;t<getNumberOfTables();t++){
+				results_.push_back(PositionListPtr(new PositionList()));
+			}
+		}
+
+		std::vector<PositionList> batch(getNumberOfTables());
+		for(unsigned int t=0;t<batch.size();t++){
+			batch[t].reserve(PIPELINE_BATCH_SIZE);
+		}
+		const size_t number_of_rows = table_sizes_.front();
+		for(size_t begin=0;begin<number_of_rows;begin+=PIPELINE_BATCH_SIZE){
+			const size_t end = std::min(begin+PIPELINE_BATCH_SIZE,number_of_rows);
+			if(operators_.empty()){
+				scan_rows(begin,end,batch[0]);
+			}else{
+				operators_.front()->scan(begin,end,batch);
+			}
+			for(unsigned int i=1;i<operators_.size() && !batch[0].empty();i++){
+				operators_[i]->push(batch);
+			}
+			if(batch[0].empty()) continue;
+			for(unsigned int i=0;i<aggregations_.size();i++){
+				aggregations_[i]->push(batch);
+			}
+			for(unsigned int t=0;t<results_.size();t++){
+				results_[t]->insert(results_[t]->end(),batch[t].begin(),batch[t].end());
+			}
+		}
+	}
+
+	const PositionListPtr Pipeline::getResult(unsigned int table) const{
+		if(table>=results_.size()) return PositionListPtr();
+		return results_[table];
+	}
+
+	const boost::any Pipeline::getAggregate(unsigned int aggregation) const{
+		if(aggregation>=aggregations_.size()) return boost::any();
+		return aggregations_[aggregation]->getResult();
+	}
+
+	unsigned int Pipeline::getNumberOfTables() const throw(){
+		return table_sizes_.size();
+	}
+
+	const std::vector<Operation> Pipeline::getOperations() const{
+		std::vector<Operation> operations(1,FULL_SCAN);
+		for(unsigned int i=0;i<operators_.size();i++){
+			operations.push_back(operators_[i]->getOperation());
+		}
+		for(unsigned int i=0;i<aggregations_.size();i++){
+			operations.push_back(aggregations_[i]->getOperation());
+		}
+		return operations;
+	}
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,226 @@
+
+#include <core/task_scheduler.hpp>
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+namespace CoGaDB{
+
+	/*! \brief marks a worker that did not look at a job yet*/
+	const int UNKNOWN_PARTICIPANT = -1;
+	/*! \brief marks a worker that may not take part in a job, because the job has all participants it may have*/
+	const int NO_PARTICIPANT = -2;
+
+	/*! \brief returns the cores the process may run on, or one unknown core (-1) per hardware thread if they cannot be determined*/
+	static std::vector<int> getAvailableCores(){
+		std::vector<int> cores;
+#ifdef __linux__
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		if(sched_getaffinity(0,sizeof(cpus),&cpus)==0){
+			for(int cpu=0;cpu<CPU_SETSIZE;cpu++){
+				if(CPU_ISSET(cpu,&cpus)) cores.push_back(cpu);
+			}
+		}
+#endif
+		if(cores.empty()){
+			cores.assign(std::max(std::thread::hardware_concurrency(),1u),-1);
+		}
+		return cores;
+	}
+
+	struct TaskScheduler::Job{
+		Job(size_t number_of_rows_, size_t morsel_size_, unsigned int maximal_participants_, const MorselFunction& function_, unsigned int number_of_workers)
+			: function(function_), number_of_rows(number_of_rows_), morsel_size(morsel_size_), maximal_participants(maximal_participants_),
+			  next_participant(1), participants(number_of_workers,UNKNOWN_PARTICIPANT), remaining_morsels((number_of_rows_+morsel_size_-1)/morsel_size_), mutex(), done(){}
+
+		const MorselFunction& function;
+		const size_t number_of_rows;
+		const size_t morsel_size;
+		const unsigned int maximal_participants;
+		/*! \brief participant number of the next worker that takes part, 0 is the thread that submitted the job*/
+		std::atomic<unsigned int> next_participant;
+		/*! \brief participant number of each worker, an entry is only accessed by its worker*/
+		std::vector<int> participants;
+		/*! \brief number of morsels that are not processed yet, protected by mutex*/
+		size_t remaining_morsels;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+
+	TaskScheduler& TaskScheduler::getInstance(){
+		static TaskScheduler scheduler;
+		return scheduler;
+	}
+
+	TaskScheduler::TaskScheduler() : cores_(getAvailableCores()), queues_(cores_.size()), workers_(), sleep_mutex_(), wake_up_(),
+		generation_(0), stop_(false), next_worker_(0){
+		for(unsigned int worker=0;worker<cores_.size();worker++){
+			workers_.push_back(std::thread(&TaskScheduler::work,this,worker));
+		}
+	}
+
+	TaskScheduler::~TaskScheduler(){
+		{
+			lock_guard<mutex> lock(sleep_mutex_);
+			stop_=true;
+		}
+		wake_up_.notify_all();
+		for(unsigned int worker=0;worker<workers_.size();worker++){
+			workers_[worker].join();
+		}
+	}
+
+	unsigned int TaskScheduler::getNumberOfWorkers() const throw(){
+		return queues_.size();
+	}
+
+	void TaskScheduler::execute(size_t number_of_rows, size_t morsel_size, unsigned int maximal_participants, const MorselFunction& function){
+		if(morsel_size==0) morsel_size=1;
+		const size_t number_of_morsels = (number_of_rows+morsel_size-1)/morsel_size;
+		if(maximal_participants<=1 || number_of_morsels<=1){
+			for(size_t begin=0;begin<number_of_rows;begin+=morsel_size){
+				function(0u,begin,std::min(begin+morsel_size,number_of_rows));
+			}
+			return;
+		}
+
+		Job job(number_of_rows,morsel_size,maximal_participants,function,queues_.size());
+		const size_t number_of_ranges = std::min<size_t>(std::min<size_t>(maximal_participants,queues_.size()),number_of_morsels);
+		const unsigned int first_worker = next_worker_.fetch_add(number_of_ranges);
+		for(size_t range=0;range<number_of_ranges;range++){
+			Task task = {&job,range*number_of_morsels/number_of_ranges,(range+1)*number_of_morsels/number_of_ranges};
+			WorkerQueue& queue = queues_[(first_worker+range)%queues_.size()];
+			lock_guard<mutex> lock(queue.mutex);
+			queue.tasks.push_back(task);
+		}
+		{
+			lock_guard<mutex> lock(sleep_mutex_);
+			generation_++;
+		}
+		wake_up_.notify_all();
+
+		//take part in the job, then wait for the morsels processed by the workers
+		Task morsel;
+		while(takeMorselOfJob(job,morsel)){
+			processMorsel(morsel,0);
+		}
+		unique_lock<mutex> lock(job.mutex);
+		job.done.wait(lock,[&job]{ return job.remaining_morsels==0; });
+	}
+
+	void TaskScheduler::work(unsigned int worker){
+#ifdef __linux__
+		if(cores_[worker]>=0){
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			CPU_SET(cores_[worker],&cpus);
+			pthread_setaffinity_np(pthread_self(),sizeof(cpus),&cpus);
+		}
+#endif
+		while(!stop_){
+			//a job submitted after this point wakes the worker up, even if it is submitted before the worker sleeps
+			const size_t generation = generation_;
+			Task morsel;
+			unsigned int participant=0;
+			if(takeMorsel(worker,morsel,participant)){
+				processMorsel(morsel,participant);
+			}else if(!stealTask(worker)){
+				unique_lock<mutex> lock(sleep_mutex_);
+				wake_up_.wait(lock,[this,generation]{ return stop_ || generation_!=generation; });
+			}
+		}
+	}
+
+	int TaskScheduler::getParticipant(Job& job, unsigned int worker){
+		int& participant = job.participants[worker];
+		if(participant==UNKNOWN_PARTICIPANT){
+			const unsigned int next_participant = job.next_participant.fetch_add(1);
+			participant = (next_participant<job.maximal_participants) ? int(next_participant) : NO_PARTICIPANT;
+		}
+		return participant;
+	}
+
+	bool TaskScheduler::takeMorsel(unsigned int worker, Task& morsel, unsigned int& participant){
+		WorkerQueue& queue = queues_[worker];
+		lock_guard<mutex> lock(queue.mutex);
+		for(std::deque<Task>::iterator it=queue.tasks.begin();it!=queue.tasks.end();++it){
+			const int job_participant = getParticipant(*it->job,worker);
+			if(job_participant<0) continue;
+			participant = job_participant;
+			morsel = *it;
+			morsel.last_morsel = morsel.first_morsel+1;
+			//the rest of the range waits behind the ranges of the other jobs
+			Task rest = *it;
+			rest.first_morsel++;
+			queue.tasks.erase(it);
+			if(rest.first_morsel<rest.last_morsel) queue.tasks.push_back(rest);
+			return true;
+		}
+		return false;
+	}
+
+	bool TaskScheduler::stealTask(unsigned int worker){
+		//workers_ is still filled while the first workers run, queues_ has its final size
+		const unsigned int number_of_workers = queues_.size();
+		for(unsigned int i=1;i<number_of_workers;i++){
+			WorkerQueue& victim = queues_[(worker+i)%number_of_workers];
+			Task stolen;
+			bool found=false;
+			{
+				lock_guard<mutex> lock(victim.mutex);
+				for(size_t t=victim.tasks.size();t>0 && !found;t--){
+					Task& task = victim.tasks[t-1];
+					if(getParticipant(*task.job,worker)<0) continue;
+					stolen = task;
+					stolen.first_morsel = task.first_morsel+(task.last_morsel-task.first_morsel)/2;
+					task.last_morsel = stolen.first_morsel;
+					if(task.first_morsel==task.last_morsel) victim.tasks.erase(victim.tasks.begin()+(t-1));
+					found=true;
+				}
+			}
+			if(found){
+				WorkerQueue& queue = queues_[worker];
+				lock_guard<mutex> lock(queue.mutex);
+				queue.tasks.push_back(stolen);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TaskScheduler::takeMorselOfJob(Job& job, Task& morsel){
+		for(unsigned int worker=0;worker<queues_.size();worker++){
+			WorkerQueue& queue = queues_[worker];
+			lock_guard<mutex> lock(queue.mutex);
+			for(size_t t=queue.tasks.size();t>0;t--){
+				Task& task = queue.tasks[t-1];
+				if(task.job!=&job) continue;
+				//the last morsel of the range, so the worker keeps scanning its range in order
+				morsel = task;
+				morsel.first_morsel = task.last_morsel-1;
+				task.last_morsel--;
+				if(task.first_morsel==task.last_morsel) queue.tasks.erase(queue.tasks.begin()+(t-1));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void TaskScheduler::processMorsel(const Task& morsel, unsigned int participant){
+		Job& job = *morsel.job;
+		const size_t begin = morsel.first_morsel*job.morsel_size;
+		const size_t end = std::min(morsel.last_morsel*job.morsel_size,job.number_of_rows);
+		job.function(participant,begin,end);
+		//the submitting thread destroys the job after the last morsel, so the job is not accessed after the mutex is released
+		lock_guard<mutex> lock(job.mutex);
+		job.remaining_morsels -= morsel.last_morsel-morsel.first_morsel;
+		if(job.remaining_morsels==0) job.done.notify_all();
+	}
+
+}; //end namespace CogaDB
+
@@ -5,10 +5,18 @@
 
 #pragma once
 
+#include <cstring>
 #include <core/compressed_column.hpp>
+#include <core/column.hpp>
+#include <core/parallel.hpp>
 
 namespace CoGaDB{
 
+/*! \brief number of rows summarized by one block of a DECompressedColumn*/
+const unsigned int DELTA_BLOCK_SIZE = 1024;
+
+template<class T>
+struct DeltaTraits;
 
 /*!
  *  \brief     This class represents a dictionary compressed column with type T, is the base class for all compressed typed column classes.
@@ -49,6 +57,11 @@ public:
 	virtual unsigned int getSizeinBytes() const throw();
 
 	virtual const ColumnPtr copy() const;
+	/*! \brief decodes the requested rows in a single forward pass, which starts at the base of a block instead of decoding all rows in between,
+	 *  unsorted TIDs are sorted first*/
+	virtual const ColumnPtr gather(PositionListPtr tids);
+	/*! \brief decodes only the blocks that contain set bits*/
+	virtual const ColumnPtr gather(BitmapPtr tids);
 
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
@@ -57,6 +70,108 @@ public:
 
 	virtual T& operator[](const int index);
 
+	/*! \brief skips blocks whose value range cannot match and accepts blocks whose value range matches completely without decoding them*/
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief processes the blocks in parallel, each block is decoded starting from its base value*/
+	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	virtual const ColumnFilterPtr createFilter(const boost::any& value_for_comparison, const ValueComparator comp);
+
+protected:
+	/*! \brief adds and substracts by changing the first delta only, multiplies by scaling the deltas and divides by decoding and re-encoding the column
+	 *  \details FLOAT columns store the deltas of the bit patterns of the values, so they are decoded and re-encoded for all operations*/
+	virtual bool applyConstantOperation(ColumnAlgebraOperation op, const T& value);
+	/*! \brief aggregates the block synopses without decoding the column*/
+	virtual void aggregateAll(AggregationState<T>& state);
+	/*! \brief sorts a copy of the TIDs and decodes forward from the base of the block of each TID*/
+	virtual void aggregatePositions(const PositionList& tids, AggregationState<T>& state);
+	/*! \brief aggregates the synopses of completely selected blocks and decodes partially selected blocks*/
+	virtual void aggregateBitmap(const Bitmap& tids, AggregationState<T>& state);
+
+private:
+	/*! \brief synopsis of DELTA_BLOCK_SIZE consecutive rows*/
+	struct DeltaBlock{
+		/*! \brief sum of all deltas before the first row of the block, decoding of the block starts from this value*/
+		typename DeltaTraits<T>::Accumulator base;
+		/*! \brief bounds of the values of the block except NaNs, which are only the bounds of a block of NaNs*/
+		T min;
+		T max;
+		/*! \brief sum of the values of the block*/
+		typename AggregationTraits<T>::SumType sum;
+		/*! \brief a NaN may match a predicate the bounds do not, so such blocks are always decoded*/
+		bool contains_nan;
+	};
+	/*! \brief (re)builds the block synopses in a single decoding pass*/
+	void buildBlocks();
+
+	/*! \brief ColumnFilter that skips or accepts whole blocks by their synopses and otherwise decodes forward from the last accessed row*/
+	class BlockFilter : public ColumnFilter{
+		public:
+		BlockFilter(const DECompressedColumn<T>& column, const ValuePredicate<T>& predicate)
+			: deltas_(DeltaTraits<T>::getDeltas(column)), blocks_(column.blocks_), predicate_(predicate), block_states_(column.blocks_.size()),
+			  next_row_(0), sum_(DeltaTraits<T>::zero()){
+			for(size_t b=0;b<blocks_.size();b++){
+				if(blocks_[b].contains_nan){
+					block_states_[b]=DECODE;
+				}else if(!predicate_.mayMatchRange(blocks_[b].min,blocks_[b].max)){
+					block_states_[b]=NO_MATCH;
+				}else if(predicate_.matchesRange(blocks_[b].min,blocks_[b].max)){
+					block_states_[b]=FULL_MATCH;
+				}else{
+					block_states_[b]=DECODE;
+				}
+			}
+		}
+
+		virtual size_t filter(TID begin, TID end, TID* result){
+			size_t number_of_matches=0;
+			for(TID i=begin;i<end;i++){
+				result[number_of_matches]=i;
+				number_of_matches+=matches(i);
+			}
+			return number_of_matches;
+		}
+
+		virtual size_t filter(const TID* candidates, size_t number_of_candidates, TID* result){
+			size_t number_of_matches=0;
+			for(size_t i=0;i<number_of_candidates;i++){
+				TID tid=candidates[i];
+				result[number_of_matches]=tid;
+				number_of_matches+=matches(tid);
+			}
+			return number_of_matches;
+		}
+
+		private:
+		enum BlockState{NO_MATCH,FULL_MATCH,DECODE};
+
+		inline bool matches(TID tid){
+			const size_t block = tid/DELTA_BLOCK_SIZE;
+			if(block_states_[block]!=DECODE) return block_states_[block]==FULL_MATCH;
+			//restart decoding at the base of the block, unless the cursor is in the same block before tid
+			const TID block_begin = block*DELTA_BLOCK_SIZE;
+			if(next_row_<block_begin || next_row_>tid+1){
+				sum_=blocks_[block].base;
+				next_row_=block_begin;
+			}
+			while(next_row_<=tid){
+				DeltaTraits<T>::accumulate(sum_,deltas_[next_row_]);
+				next_row_++;
+			}
+			return predicate_(DeltaTraits<T>::decode(sum_));
+		}
+
+		const std::vector<typename DeltaTraits<T>::Accumulator>& deltas_;
+		const std::vector<DeltaBlock>& blocks_;
+		ValuePredicate<T> predicate_;
+		std::vector<char> block_states_;
+		/*! \brief next row to decode, sum_ is the running sum up to the row before*/
+		TID next_row_;
+		typename DeltaTraits<T>::Accumulator sum_;
+	};
+
+	std::vector<DeltaBlock> blocks_;
+	/*! \brief the block synopses are invalidated by every modification and rebuilt lazily by the next scan*/
+	bool blocks_valid_;
 };
 
 
@@ -64,12 +179,12 @@ public:
 
 
 	template<class T>
-	DECompressedColumn<T>::DECompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type),compressed_vector(),icompressed_vector(),iTotalValue(0),TotalValue(0),Return_Variable(0) {
+	DECompressedColumn<T>::DECompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type),compressed_vector(),icompressed_vector(),iTotalValue(0),TotalValue(0),Return_Variable(0),blocks_(),blocks_valid_(false) {
 
 	}
 
 	template<>
-	DECompressedColumn<std::string>::DECompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<std::string>(name, db_type),compressed_vector(),icompressed_vector(),iTotalValue(0),TotalValue(""),Return_Variable("") {
+	DECompressedColumn<std::string>::DECompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<std::string>(name, db_type),compressed_vector(),icompressed_vector(),iTotalValue(0),TotalValue(""),Return_Variable(""),blocks_(),blocks_valid_(false) {
 
 	}
 
@@ -108,6 +223,9 @@ public:
 		}
 
 		compressed_vector.push_back(insertvalue);
+		blocks_valid_=false;
+		this->statistics_.insert(value);
+		this->indexInsert(value);
 
 		return true;
 	}
@@ -129,6 +247,9 @@ public:
 			iTotalValue=insertvalue;
 		}
 		icompressed_vector.push_back(insertvalue);
+		blocks_valid_=false;
+		this->statistics_.insert(value);
+		this->indexInsert(value);
 
 		return true;
 	}
@@ -177,6 +298,36 @@ public:
 		return diff;
 	}
 
+	/*! \brief DeltaTraits describe how the deltas of a DECompressedColumn<T> are accumulated to the values*/
+	template<class T>
+	struct DeltaTraits{
+		/*! \brief type of the deltas and their running sum*/
+		typedef T Accumulator;
+		static inline Accumulator zero(){ return Accumulator(0); }
+		static inline void accumulate(Accumulator& sum, const Accumulator& delta){ sum+=delta; }
+		static inline T decode(const Accumulator& sum){ return sum; }
+		static inline const std::vector<Accumulator>& getDeltas(const DECompressedColumn<T>& column){ return column.compressed_vector; }
+	};
+
+	/*! \brief floats are delta encoded on their bit pattern*/
+	template<>
+	struct DeltaTraits<float>{
+		typedef int Accumulator;
+		static inline Accumulator zero(){ return 0; }
+		static inline void accumulate(Accumulator& sum, const Accumulator& delta){ sum+=delta; }
+		static inline float decode(const Accumulator& sum){ float value; std::memcpy(&value,&sum,sizeof(value)); return value; }
+		static inline const std::vector<Accumulator>& getDeltas(const DECompressedColumn<float>& column){ return column.icompressed_vector; }
+	};
+
+	template<>
+	struct DeltaTraits<std::string>{
+		typedef std::string Accumulator;
+		static inline Accumulator zero(){ return std::string(); }
+		static inline void accumulate(Accumulator& sum, const Accumulator& delta){ sum=stringadd(sum,delta); }
+		static inline std::string decode(const Accumulator& sum){ return sum; }
+		static inline const std::vector<Accumulator>& getDeltas(const DECompressedColumn<std::string>& column){ return column.compressed_vector; }
+	};
+
 	template<>
 	bool DECompressedColumn<std::string>::insert(const std::string& value)
 	{
@@ -194,6 +345,9 @@ public:
 		}
 
 		compressed_vector.push_back(insertvalue);
+		blocks_valid_=false;
+		this->statistics_.insert(value);
+		this->indexInsert(value);
 
 		return true;
 	}
@@ -315,6 +469,59 @@ public:
 		return ColumnPtr(new DECompressedColumn<T>((*this)));
 	}
 
+	template<class T>
+	const ColumnPtr DECompressedColumn<T>::gather(PositionListPtr tids){
+		typedef DeltaTraits<T> Traits;
+		if(!tids || !is_valid_position_list(*tids,this->size())) return ColumnPtr();
+		if(!blocks_valid_) buildBlocks();
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.resize(tids->size());
+		const bool sorted = is_sorted_position_list(*tids);
+		std::vector<std::pair<TID,TID> > positions;
+		if(!sorted) positions = sort_positions(*tids);
+
+		typename Traits::Accumulator sum = Traits::zero();
+		TID next_row=0;
+		for(size_t i=0;i<tids->size();i++){
+			TID tid = sorted ? (*tids)[i] : positions[i].first;
+			TID block_begin = (tid/DELTA_BLOCK_SIZE)*DELTA_BLOCK_SIZE;
+			if(next_row<block_begin){
+				sum=blocks_[tid/DELTA_BLOCK_SIZE].base;
+				next_row=block_begin;
+			}
+			while(next_row<=tid){
+				Traits::accumulate(sum,deltas[next_row]);
+				next_row++;
+			}
+			result_values[sorted ? i : positions[i].second]=Traits::decode(sum);
+		}
+		return result;
+	}
+
+	template<class T>
+	const ColumnPtr DECompressedColumn<T>::gather(BitmapPtr tids){
+		typedef DeltaTraits<T> Traits;
+		if(!tids || tids->size()!=this->size()) return ColumnPtr();
+		if(!blocks_valid_) buildBlocks();
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(this->name_,this->db_type_));
+		std::vector<T>& result_values = result->getContent();
+		result_values.reserve(tids->count());
+		for(size_t b=0;b<blocks_.size();b++){
+			TID begin = b*DELTA_BLOCK_SIZE;
+			TID end = std::min<size_t>(begin+DELTA_BLOCK_SIZE,deltas.size());
+			if(tids->count(begin,end)==0) continue;
+			typename Traits::Accumulator sum = blocks_[b].base;
+			for(TID i=begin;i<end;i++){
+				Traits::accumulate(sum,deltas[i]);
+				if(tids->test(i)) result_values.push_back(Traits::decode(sum));
+			}
+		}
+		return result;
+	}
+
 	template<class T>
 	bool DECompressedColumn<T>::update(TID id , const boost::any& updatesvalue )
 	{
@@ -341,6 +548,9 @@ public:
 			}
 
 			TotalValue=updatedLastCount;
+			blocks_valid_=false;
+			this->statistics_.update(value,1);
+			this->invalidateIndex();
 			return true;
 		}else{
 			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl; 
@@ -373,6 +583,9 @@ public:
 			}
 
 			iTotalValue=updatedLastCount;
+			blocks_valid_=false;
+			this->statistics_.update(val,1);
+			this->invalidateIndex();
 
 			return true;
 		}else{
@@ -406,6 +619,9 @@ public:
 			}
 
 			TotalValue=updatedLastCount;
+			blocks_valid_=false;
+			this->statistics_.update(value,1);
+			this->invalidateIndex();
 
 			return true;
 		}else{
@@ -463,6 +679,8 @@ public:
 			std::vector<int> icompressed_vector_ = icompressed_vector;
 			icompressed_vector.clear();
 			iTotalValue=0;
+			this->statistics_.clear();
+			this->invalidateIndex();
 
 			for(unsigned int id=0;id<tids->size();id++){
 				TID tid=(*tids)[id];
@@ -501,6 +719,8 @@ public:
 			std::vector<std::string> compressed_vector_ = compressed_vector;
 			compressed_vector.clear();
 			TotalValue="";
+			this->statistics_.clear();
+			this->invalidateIndex();
 
 			for(unsigned int id=0;id<tids->size();id++){
 				TID tid=(*tids)[id];
@@ -535,6 +755,9 @@ public:
 		T valueToDelete=compressed_vector[id];
 		compressed_vector[id+1]+=valueToDelete;
 		compressed_vector.erase(compressed_vector.begin()+id);
+		blocks_valid_=false;
+		this->statistics_.remove(1);
+		this->invalidateIndex();
 		return false;
 	}
 
@@ -544,6 +767,9 @@ public:
 		int valueToDelete=icompressed_vector[id];
 		icompressed_vector[id+1]+=valueToDelete;
 		icompressed_vector.erase(icompressed_vector.begin()+id);
+		blocks_valid_=false;
+		this->statistics_.remove(1);
+		this->invalidateIndex();
 		return false;
 	}
 
@@ -553,6 +779,9 @@ public:
 		std::string valueToDelete=compressed_vector[id];
 		compressed_vector[id+1]=stringadd(compressed_vector[id+1],valueToDelete);
 		compressed_vector.erase(compressed_vector.begin()+id);
+		blocks_valid_=false;
+		this->statistics_.remove(1);
+		this->invalidateIndex();
 		return false;
 	}
 
@@ -577,6 +806,9 @@ public:
 	bool DECompressedColumn<T>::clearContent(){
 		compressed_vector.clear();
 		TotalValue=0;
+		blocks_valid_=false;
+		this->statistics_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -584,6 +816,9 @@ public:
 	bool DECompressedColumn<float>::clearContent(){
 		icompressed_vector.clear();
 		iTotalValue=0;
+		blocks_valid_=false;
+		this->statistics_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -591,6 +826,9 @@ public:
 	bool DECompressedColumn<std::string>::clearContent(){
 		compressed_vector.clear();
 		TotalValue="";
+		blocks_valid_=false;
+		this->statistics_.clear();
+		this->invalidateIndex();
 		return true;
 	}
 
@@ -642,6 +880,8 @@ public:
 		ia >> TotalValue;
 		ia >> compressed_vector;
 		infile.close();
+		this->statistics_.invalidate();
+		this->invalidateIndex();
 
 		return true;
 	}
@@ -659,6 +899,8 @@ public:
 		ia >> iTotalValue;
 		ia >> icompressed_vector;
 		infile.close();
+		this->statistics_.invalidate();
+		this->invalidateIndex();
 
 		return true;
 	}
@@ -709,6 +951,202 @@ public:
 		return Return_Variable;
 	}
 
+	template<class T>
+	void DECompressedColumn<T>::buildBlocks(){
+		typedef DeltaTraits<T> Traits;
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+
+		blocks_.clear();
+		typename Traits::Accumulator sum = Traits::zero();
+		for(size_t begin=0;begin<deltas.size();begin+=DELTA_BLOCK_SIZE){
+			size_t end=std::min<size_t>(begin+DELTA_BLOCK_SIZE,deltas.size());
+			DeltaBlock block = {sum,T(),T(),AggregationTraits<T>::zero(),false};
+			for(size_t i=begin;i<end;i++){
+				Traits::accumulate(sum,deltas[i]);
+				T value = Traits::decode(sum);
+				//a NaN does not bound the block, unless all values are NaN
+				if(i==begin || value<block.min || is_unordered(block.min,block.min)) block.min=value;
+				if(i==begin || block.max<value || is_unordered(block.max,block.max)) block.max=value;
+				if(is_unordered(value,value)) block.contains_nan=true;
+				AggregationTraits<T>::addToSum(block.sum,value,1);
+			}
+			blocks_.push_back(block);
+		}
+		blocks_valid_=true;
+	}
+
+	template<class T>
+	const PositionListPtr DECompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return this->parallel_selection(value_for_comparison,comp,getNumberOfThreads(this->size()));
+	}
+
+	template<class T>
+	const PositionListPtr DECompressedColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		typedef DeltaTraits<T> Traits;
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		PositionListPtr index_tids = this->indexSelection(predicate);
+		if(index_tids) return index_tids;
+		if(!blocks_valid_) buildBlocks();
+
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+		const std::vector<DeltaBlock>& blocks = blocks_;
+		return parallel_scan(blocks.size(),number_of_threads,
+			[&deltas,&blocks,&predicate](size_t first_block, size_t last_block, PositionList& result){
+				for(size_t b=first_block;b<last_block;b++){
+					const DeltaBlock& block = blocks[b];
+					if(!block.contains_nan && !predicate.mayMatchRange(block.min,block.max)) continue;
+					TID begin = b*DELTA_BLOCK_SIZE;
+					TID end = std::min<size_t>(begin+DELTA_BLOCK_SIZE,deltas.size());
+					if(!block.contains_nan && predicate.matchesRange(block.min,block.max)){
+						for(TID i=begin;i<end;i++) result.push_back(i);
+						continue;
+					}
+					typename Traits::Accumulator sum = block.base;
+					for(TID i=begin;i<end;i++){
+						Traits::accumulate(sum,deltas[i]);
+						if(predicate(Traits::decode(sum))) result.push_back(i);
+					}
+				}
+			},MORSEL_SIZE/DELTA_BLOCK_SIZE);
+	}
+
+	template<class T>
+	const ColumnFilterPtr DECompressedColumn<T>::createFilter(const boost::any& value_for_comparison, const ValueComparator comp){
+		const ValuePredicate<T> predicate = this->getPredicate(value_for_comparison,comp);
+		if(!blocks_valid_) buildBlocks();
+		return ColumnFilterPtr(new BlockFilter(*this,predicate));
+	}
+
+	template<class T>
+	bool DECompressedColumn<T>::applyConstantOperation(ColumnAlgebraOperation op, const T& value){
+		if(!is_valid_operand(op,value)) return false;
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		if(compressed_vector.empty()) return true;
+
+		if(op==ADD || op==SUB){
+			T offset = value;
+			if(op==SUB) offset = T(0)-value;
+			//the first delta is the first value, all following values are sums over it
+			compressed_vector[0]+=offset;
+			TotalValue+=offset;
+			if(blocks_valid_){
+				for(size_t b=0;b<blocks_.size();b++){
+					size_t number_of_rows = std::min<size_t>(DELTA_BLOCK_SIZE,compressed_vector.size()-b*DELTA_BLOCK_SIZE);
+					if(b>0) blocks_[b].base+=offset;
+					blocks_[b].min+=offset;
+					blocks_[b].max+=offset;
+					AggregationTraits<T>::addToSum(blocks_[b].sum,offset,number_of_rows);
+				}
+			}
+		}else if(op==MUL){
+			//the deltas of the products are the products of the deltas
+			apply_constant_operation(compressed_vector.data(),compressed_vector.size(),MUL,value);
+			TotalValue*=value;
+			blocks_valid_=false;
+		}else{
+			T previous_value=T(0);
+			T previous_result=T(0);
+			for(size_t i=0;i<compressed_vector.size();i++){
+				previous_value+=compressed_vector[i];
+				T result = previous_value;
+				apply_operation(result,op,value);
+				compressed_vector[i]=result-previous_result;
+				previous_result=result;
+			}
+			TotalValue=previous_result;
+			blocks_valid_=false;
+		}
+		return true;
+	}
+
+	template<>
+	bool DECompressedColumn<float>::applyConstantOperation(ColumnAlgebraOperation op, const float& value){
+		if(!is_valid_operand(op,value)) return false;
+		this->statistics_.invalidate();
+		this->invalidateIndex();
+		//the deltas are computed on the bit patterns of the values, use unsigned arithmetic, so that overflows wrap around
+		uint32_t previous_bits=0;
+		uint32_t previous_result_bits=0;
+		for(size_t i=0;i<icompressed_vector.size();i++){
+			previous_bits+=static_cast<uint32_t>(icompressed_vector[i]);
+			float result;
+			std::memcpy(&result,&previous_bits,sizeof(result));
+			apply_operation(result,op,value);
+			uint32_t result_bits;
+			std::memcpy(&result_bits,&result,sizeof(result_bits));
+			icompressed_vector[i]=static_cast<int>(result_bits-previous_result_bits);
+			previous_result_bits=result_bits;
+		}
+		iTotalValue=static_cast<int>(previous_result_bits);
+		blocks_valid_=false;
+		return true;
+	}
+
+	template<>
+	bool DECompressedColumn<std::string>::applyConstantOperation(ColumnAlgebraOperation, const std::string&){
+		return false;
+	}
+
+	template<class T>
+	void DECompressedColumn<T>::aggregateAll(AggregationState<T>& state){
+		if(!blocks_valid_) buildBlocks();
+		const size_t number_of_rows = DeltaTraits<T>::getDeltas(*this).size();
+		for(size_t b=0;b<blocks_.size();b++){
+			size_t begin = b*DELTA_BLOCK_SIZE;
+			size_t end = std::min<size_t>(begin+DELTA_BLOCK_SIZE,number_of_rows);
+			state.add(end-begin,blocks_[b].sum,blocks_[b].min,blocks_[b].max);
+		}
+	}
+
+	template<class T>
+	void DECompressedColumn<T>::aggregatePositions(const PositionList& tids, AggregationState<T>& state){
+		typedef DeltaTraits<T> Traits;
+		if(!blocks_valid_) buildBlocks();
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+		PositionList sorted_tids(tids);
+		std::sort(sorted_tids.begin(),sorted_tids.end());
+
+		typename Traits::Accumulator sum = Traits::zero();
+		TID next_row=0;
+		for(size_t i=0;i<sorted_tids.size();i++){
+			TID tid = sorted_tids[i];
+			TID block_begin = (tid/DELTA_BLOCK_SIZE)*DELTA_BLOCK_SIZE;
+			//jump to the base of the block instead of decoding all rows in between
+			if(next_row<block_begin){
+				sum=blocks_[tid/DELTA_BLOCK_SIZE].base;
+				next_row=block_begin;
+			}
+			while(next_row<=tid){
+				Traits::accumulate(sum,deltas[next_row]);
+				next_row++;
+			}
+			state.add(Traits::decode(sum));
+		}
+	}
+
+	template<class T>
+	void DECompressedColumn<T>::aggregateBitmap(const Bitmap& tids, AggregationState<T>& state){
+		typedef DeltaTraits<T> Traits;
+		if(!blocks_valid_) buildBlocks();
+		const std::vector<typename Traits::Accumulator>& deltas = Traits::getDeltas(*this);
+		for(size_t b=0;b<blocks_.size();b++){
+			TID begin = b*DELTA_BLOCK_SIZE;
+			TID end = std::min<size_t>(begin+DELTA_BLOCK_SIZE,deltas.size());
+			size_t number_of_selected_rows = tids.count(begin,end);
+			if(number_of_selected_rows==0) continue;
+			if(number_of_selected_rows==end-begin){
+				state.add(end-begin,blocks_[b].sum,blocks_[b].min,blocks_[b].max);
+				continue;
+			}
+			typename Traits::Accumulator sum = blocks_[b].base;
+			for(TID i=begin;i<end;i++){
+				Traits::accumulate(sum,deltas[i]);
+				if(tids.test(i)) state.add(Traits::decode(sum));
+			}
+		}
+	}
+
 	template<class T>
 	unsigned int DECompressedColumn<T>::getSizeinBytes() const throw(){
 		return sizeof(T) * compressed_vector.size();
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     A Bitmap is a selection result that stores one bit per row of a column, the bit of a TID is set if the row qualifies.
+ *  \details   A Bitmap needs one bit per row, while a PositionList needs sizeof(TID)*8 bits per qualifying row.
+ *             Hence, a Bitmap is the smaller representation as soon as more than 1/(sizeof(TID)*8) of the rows qualify.
+ *             Conjunctions and disjunctions of selections are computed with word wise AND/OR instead of merging position lists.
+ */
+class Bitmap{
+	public:
+	/*! \brief creates a Bitmap for number_of_rows rows, all bits are set to value*/
+	explicit Bitmap(size_t number_of_rows=0, bool value=false);
+
+	/*! \brief returns the number of rows (bits) of the Bitmap*/
+	size_t size() const throw(){ return number_of_rows_; }
+	/*! \brief returns the number of set bits*/
+	size_t count() const;
+	/*! \brief returns the number of set bits of the TIDs in [begin,end)*/
+	size_t count(TID begin, TID end) const;
+
+	inline bool test(TID tid) const{ return (words_[tid/64] >> (tid%64)) & 1; }
+	inline void set(TID tid){ words_[tid/64] |= uint64_t(1) << (tid%64); }
+	inline void reset(TID tid){ words_[tid/64] &= ~(uint64_t(1) << (tid%64)); }
+	/*! \brief sets the bits of all TIDs in [begin,end)*/
+	void setRange(TID begin, TID end);
+
+	/*! \brief intersection, both Bitmaps have to have the same size*/
+	Bitmap& operator&=(const Bitmap& bitmap);
+	/*! \brief union, both Bitmaps have to have the same size*/
+	Bitmap& operator|=(const Bitmap& bitmap);
+	/*! \brief negation, inverts all bits*/
+	Bitmap& flip();
+	bool operator==(const Bitmap& bitmap) const;
+
+	/*! \brief returns the TIDs of all set bits in ascending order*/
+	const PositionListPtr toPositionList() const;
+	/*! \brief creates a Bitmap for number_of_rows rows from a PositionList*/
+	static const shared_pointer_namespace::shared_ptr<Bitmap> fromPositionList(const PositionList& tids, size_t number_of_rows);
+
+	/*! \brief returns the words of the Bitmap, bit i%64 of word i/64 belongs to TID i, unused bits of the last word are zero*/
+	std::vector<uint64_t>& getWords() throw(){ return words_; }
+	const std::vector<uint64_t>& getWords() const throw(){ return words_; }
+
+	private:
+	/*! \brief sets the unused bits of the last word to zero*/
+	void clearUnusedBits();
+
+	std::vector<uint64_t> words_;
+	size_t number_of_rows_;
+};
+
+
+/*!
+ *  \brief     A SelectionResult holds the result of a selection either as PositionList or as Bitmap and converts on demand.
+ */
+class SelectionResult{
+	public:
+	explicit SelectionResult(PositionListPtr tids, size_t number_of_rows);
+	explicit SelectionResult(BitmapPtr bitmap);
+
+	bool isBitmap() const throw(){ return bitmap_.get()!=NULL; }
+	/*! \brief returns the number of qualifying rows*/
+	size_t count() const;
+	/*! \brief returns the result as PositionList, converts the Bitmap if necessary*/
+	const PositionListPtr getPositionList() const;
+	/*! \brief returns the result as Bitmap, converts the PositionList if necessary*/
+	const BitmapPtr getBitmap() const;
+
+	private:
+	PositionListPtr tids_;
+	BitmapPtr bitmap_;
+	size_t number_of_rows_;
+};
+
+}; //end namespace CogaDB
+
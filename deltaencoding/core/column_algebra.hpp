@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <core/global_definitions.hpp>
+
+namespace CoGaDB{
+
+/*! \brief returns false if the constant cannot be used as operand of the operation, i.e., if it is zero for DIV or T is not numeric*/
+template<class T>
+inline bool is_valid_operand(ColumnAlgebraOperation op, const T& value){
+	//check that we do not devide by zero
+	return op!=DIV || !(value==T(0));
+}
+
+template<>
+inline bool is_valid_operand<std::string>(ColumnAlgebraOperation, const std::string&){
+	return false;
+}
+
+/*! \brief applies a ColumnAlgebraOperation with a constant to a single value
+ *  \return false if the operation is not defined for type T*/
+template<class T>
+inline bool apply_operation(T& x, ColumnAlgebraOperation op, const T& value){
+	switch(op){
+		case ADD: x+=value; return true;
+		case SUB: x-=value; return true;
+		case MUL: x*=value; return true;
+		case DIV: x/=value; return true;
+	}
+	return false;
+}
+
+template<>
+inline bool apply_operation<std::string>(std::string&, ColumnAlgebraOperation, const std::string&){
+	return false;
+}
+
+/*! \brief arithmetic functors, which are applied in place to vectors of values as well as to single values*/
+struct AddOperation{ template<class V> inline void operator()(V& a, const V& b) const { a+=b; } };
+struct SubOperation{ template<class V> inline void operator()(V& a, const V& b) const { a-=b; } };
+struct MulOperation{ template<class V> inline void operator()(V& a, const V& b) const { a*=b; } };
+struct DivOperation{ template<class V> inline void operator()(V& a, const V& b) const { a/=b; } };
+
+/*! \brief computes result[i]=operation(left[i],right[i]) with vector instructions, result may be equal to left or right*/
+template<class T, class Operation>
+void simd_transform(T* result, const T* left, const T* right, size_t number_of_values, Operation operation){
+	const size_t LANES = 8;
+	typedef T Vector __attribute__((vector_size(LANES*sizeof(T))));
+	size_t i=0;
+	for(;i+LANES<=number_of_values;i+=LANES){
+		Vector a, b;
+		std::memcpy(&a,left+i,sizeof(Vector));
+		std::memcpy(&b,right+i,sizeof(Vector));
+		operation(a,b);
+		std::memcpy(result+i,&a,sizeof(Vector));
+	}
+	for(;i<number_of_values;i++){
+		T a = left[i];
+		operation(a,right[i]);
+		result[i]=a;
+	}
+}
+
+/*! \brief computes result[i]=operation(left[i],value) with vector instructions, result may be equal to left*/
+template<class T, class Operation>
+void simd_transform_constant(T* result, const T* left, const T& value, size_t number_of_values, Operation operation){
+	const size_t LANES = 8;
+	typedef T Vector __attribute__((vector_size(LANES*sizeof(T))));
+	Vector b;
+	for(size_t lane=0;lane<LANES;lane++) b[lane]=value;
+	size_t i=0;
+	for(;i+LANES<=number_of_values;i+=LANES){
+		Vector a;
+		std::memcpy(&a,left+i,sizeof(Vector));
+		operation(a,b);
+		std::memcpy(result+i,&a,sizeof(Vector));
+	}
+	for(;i<number_of_values;i++){
+		T a = left[i];
+		operation(a,value);
+		result[i]=a;
+	}
+}
+
+/*! \brief computes result[i]=left[i] op value for arrays of numeric values, result may be equal to left
+ *  \details the operation is resolved once, not per value
+ *  \return false if the operation is not defined for type T or the constant is zero for DIV*/
+template<class T>
+bool apply_constant_operation(T* result, const T* left, size_t number_of_values, ColumnAlgebraOperation op, const T& value){
+	if(!is_valid_operand(op,value)) return false;
+	switch(op){
+		case ADD: simd_transform_constant(result,left,value,number_of_values,AddOperation()); return true;
+		case SUB: simd_transform_constant(result,left,value,number_of_values,SubOperation()); return true;
+		case MUL: simd_transform_constant(result,left,value,number_of_values,MulOperation()); return true;
+		case DIV: simd_transform_constant(result,left,value,number_of_values,DivOperation()); return true;
+	}
+	return false;
+}
+
+template<>
+inline bool apply_constant_operation<std::string>(std::string*, const std::string*, size_t, ColumnAlgebraOperation, const std::string&){
+	return false;
+}
+
+/*! \brief computes values[i]=values[i] op value in place*/
+template<class T>
+inline bool apply_constant_operation(T* values, size_t number_of_values, ColumnAlgebraOperation op, const T& value){
+	return apply_constant_operation(values,values,number_of_values,op,value);
+}
+
+/*! \brief returns false if the values cannot be used as right operands of the operation, i.e., if an integer would be divided by zero or T is not numeric*/
+template<class T>
+bool is_valid_operand_array(ColumnAlgebraOperation op, const T* values, size_t number_of_values){
+	if(op!=DIV || !std::numeric_limits<T>::is_integer) return true;
+	for(size_t i=0;i<number_of_values;i++){
+		if(values[i]==T(0)) return false;
+	}
+	return true;
+}
+
+template<>
+inline bool is_valid_operand_array<std::string>(ColumnAlgebraOperation, const std::string*, size_t){
+	return false;
+}
+
+/*! \brief computes result[i]=left[i] op right[i] for arrays of numeric values, result may be equal to left or right
+ *  \details the right operands have to be checked with is_valid_operand_array before, so that large arrays can be processed in chunks
+ *  \return false if the operation is not defined for type T*/
+template<class T>
+bool apply_column_operation(T* result, const T* left, const T* right, size_t number_of_values, ColumnAlgebraOperation op){
+	switch(op){
+		case ADD: simd_transform(result,left,right,number_of_values,AddOperation()); return true;
+		case SUB: simd_transform(result,left,right,number_of_values,SubOperation()); return true;
+		case MUL: simd_transform(result,left,right,number_of_values,MulOperation()); return true;
+		case DIV: simd_transform(result,left,right,number_of_values,DivOperation()); return true;
+	}
+	return false;
+}
+
+template<>
+inline bool apply_column_operation<std::string>(std::string*, const std::string*, const std::string*, size_t, ColumnAlgebraOperation){
+	return false;
+}
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include <boost/any.hpp>
+#include <core/global_definitions.hpp>
+#include <core/hash_function.hpp>
+#include <core/predicate.hpp>
+
+namespace CoGaDB{
+
+/*! \brief a HyperLogLog sketch has 2^HYPERLOGLOG_PRECISION registers, its standard error is about 1.04/sqrt(2^HYPERLOGLOG_PRECISION)*/
+const unsigned int HYPERLOGLOG_PRECISION = 10;
+/*! \brief number of buckets of an EquiDepthHistogram*/
+const unsigned int HISTOGRAM_NUMBER_OF_BUCKETS = 64;
+/*! \brief fraction of rows that may change before the statistics of a column are rebuilt*/
+const double STATISTICS_REBUILD_FRACTION = 0.1;
+
+/*!
+ *  \brief     A HyperLogLog sketch estimates the number of distinct values of a multiset in constant space, values are added by their 64 bit hash.
+ */
+class HyperLogLog{
+	public:
+	HyperLogLog();
+	inline void add(uint64_t hash){
+		//the upper bits select the register, the remaining bits determine the rank
+		const size_t index = hash >> (64-HYPERLOGLOG_PRECISION);
+		const uint64_t remaining_bits = (hash << HYPERLOGLOG_PRECISION) | (uint64_t(1) << (HYPERLOGLOG_PRECISION-1));
+		const uint8_t rank = static_cast<uint8_t>(__builtin_clzll(remaining_bits)+1);
+		if(rank>registers_[index]) registers_[index]=rank;
+	}
+	/*! \brief returns the estimated number of distinct values added so far*/
+	double estimate() const;
+	void clear();
+
+	private:
+	std::vector<uint8_t> registers_;
+};
+
+/*!
+ *  \brief     An EquiDepthHistogram divides the sorted values of a column into HISTOGRAM_NUMBER_OF_BUCKETS buckets with the same number of rows
+ *             and stores the boundaries of the buckets, which is sufficient to estimate the fraction of rows below a value.
+ */
+template<class T>
+class EquiDepthHistogram{
+	public:
+	EquiDepthHistogram() : bounds_(){}
+	/*! \brief builds the histogram from the sorted values of a column*/
+	void build(const std::vector<T>& sorted_values);
+	bool empty() const throw(){ return bounds_.empty(); }
+	/*! \brief returns the estimated fraction of rows with a value lesser than (or equal to) value*/
+	double estimateLesser(const T& value, bool or_equal) const;
+	/*! \brief returns the estimated fraction of rows equal to value, values spanning several buckets are frequent values*/
+	double estimateEqual(const T& value, double number_of_distinct_values) const;
+
+	private:
+	/*! \brief bounds_[i] is the value at the i/HISTOGRAM_NUMBER_OF_BUCKETS quantile, bounds_.front() is the minimum and bounds_.back() the maximum*/
+	std::vector<T> bounds_;
+};
+
+/*!
+ *  \brief     ColumnStatistics describe the contents of a column: number of rows, minimum, maximum, sortedness, number of distinct values and
+ *             the distribution of the values, so operators can choose algorithms and predicate orders without scanning the column.
+ *  \details   Columns update their statistics on every insert, update and remove. Inserts keep all statistics exact, except for the
+ *             estimates of the HyperLogLog sketch and the histogram. After updates and removes, the minimum and maximum are bounds of the values
+ *             and a column is only reported as sorted, if it is known to be sorted. The statistics are rebuilt from the column as soon as more than
+ *             STATISTICS_REBUILD_FRACTION of the rows changed since the last rebuild. The column does not contain NULL values, so there is no null count.
+ */
+class ColumnStatistics{
+	public:
+	ColumnStatistics();
+	virtual ~ColumnStatistics();
+
+	size_t getNumberOfRows() const throw(){ return number_of_rows_; }
+	/*! \brief returns true if the values are known to be sorted ascending*/
+	bool isSortedAscending() const throw(){ return sorted_ascending_; }
+	/*! \brief returns true if the values are known to be sorted descending*/
+	bool isSortedDescending() const throw(){ return sorted_descending_; }
+	/*! \brief returns true if the statistics were maintained for all modifications of a column with number_of_rows rows, 
+	 *  so operators can rely on the sortedness without rebuilding the statistics*/
+	bool isCurrent(size_t number_of_rows) const throw(){ return valid_ && number_of_rows_==number_of_rows; }
+	/*! \brief returns the estimated number of distinct values*/
+	double getNumberOfDistinctValues() const;
+	/*! \brief returns the smallest value or an empty object for an empty column*/
+	virtual const boost::any getMinimum() const=0;
+	/*! \brief returns the largest value or an empty object for an empty column*/
+	virtual const boost::any getMaximum() const=0;
+	/*! \brief returns the estimated fraction of rows that match the filter condition consisting of a comparison value and a ValueComparator*/
+	virtual double estimateSelectivity(const boost::any& value_for_comparison, const ValueComparator comp) const=0;
+
+	/*! \brief returns true if the statistics have to be rebuilt from the column*/
+	bool needsRebuild() const throw();
+	/*! \brief marks the statistics as outdated, e.g., after all values were modified*/
+	void invalidate() throw(){ valid_=false; }
+
+	protected:
+	size_t number_of_rows_;
+	bool sorted_ascending_;
+	bool sorted_descending_;
+	bool valid_;
+	/*! \brief number of rows inserted, updated or removed since the last rebuild*/
+	size_t number_of_changes_;
+	/*! \brief number of rows at the last rebuild*/
+	size_t number_of_rows_at_rebuild_;
+	HyperLogLog distinct_values_;
+};
+
+/*!
+ *  \brief     TypedColumnStatistics are the ColumnStatistics of a column with values of type T.
+ */
+template<class T>
+class TypedColumnStatistics : public ColumnStatistics{
+	public:
+	TypedColumnStatistics();
+
+	/*! \brief updates the statistics for a value appended to the column*/
+	void insert(const T& value);
+	/*! \brief updates the statistics for number_of_rows rows set to value
+	 *  \details keeps_order is true if the updated rows still lie between their neighbors, so the column stays sorted*/
+	void update(const T& value, size_t number_of_rows, bool keeps_order=false);
+	/*! \brief updates the statistics for number_of_rows removed rows*/
+	void remove(size_t number_of_rows);
+	/*! \brief resets the statistics to the statistics of an empty column*/
+	void clear();
+	/*! \brief recomputes all statistics from the values of the column*/
+	void rebuild(const std::vector<T>& values);
+
+	const T& getMin() const throw(){ return min_; }
+	const T& getMax() const throw(){ return max_; }
+	virtual const boost::any getMinimum() const;
+	virtual const boost::any getMaximum() const;
+	virtual double estimateSelectivity(const boost::any& value_for_comparison, const ValueComparator comp) const;
+	double estimateSelectivity(const ValuePredicate<T>& predicate) const;
+
+	private:
+	T min_;
+	T max_;
+	/*! \brief last inserted value, to check whether inserts keep the column sorted*/
+	T last_;
+	EquiDepthHistogram<T> histogram_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	void EquiDepthHistogram<T>::build(const std::vector<T>& sorted_values){
+		bounds_.clear();
+		if(sorted_values.empty()) return;
+		bounds_.reserve(HISTOGRAM_NUMBER_OF_BUCKETS+1);
+		for(size_t i=0;i<HISTOGRAM_NUMBER_OF_BUCKETS;++i){
+			bounds_.push_back(sorted_values[(i*sorted_values.size())/HISTOGRAM_NUMBER_OF_BUCKETS]);
+		}
+		bounds_.push_back(sorted_values.back());
+	}
+
+	template<class T>
+	double EquiDepthHistogram<T>::estimateLesser(const T& value, bool or_equal) const{
+		if(bounds_.empty()) return 1.0;
+		size_t position = or_equal ? std::upper_bound(bounds_.begin(),bounds_.end(),value)-bounds_.begin()
+		                           : std::lower_bound(bounds_.begin(),bounds_.end(),value)-bounds_.begin();
+		if(position==0) return 0.0;
+		if(position==bounds_.size()) return 1.0;
+		//value lies in bucket position-1, half of its rows are assumed to qualify
+		return (position-0.5)/HISTOGRAM_NUMBER_OF_BUCKETS;
+	}
+
+	template<class T>
+	double EquiDepthHistogram<T>::estimateEqual(const T& value, double number_of_distinct_values) const{
+		if(bounds_.empty()) return 1.0;
+		if(value<bounds_.front() || bounds_.back()<value) return 0.0;
+		size_t number_of_bounds = std::upper_bound(bounds_.begin(),bounds_.end(),value)-std::lower_bound(bounds_.begin(),bounds_.end(),value);
+		double selectivity = 1.0/std::max(number_of_distinct_values,1.0);
+		if(number_of_bounds>1) selectivity = std::max(selectivity,double(number_of_bounds-1)/HISTOGRAM_NUMBER_OF_BUCKETS);
+		return std::min(selectivity,1.0);
+	}
+
+	template<class T>
+	TypedColumnStatistics<T>::TypedColumnStatistics() : ColumnStatistics(), min_(), max_(), last_(), histogram_(){
+
+	}
+
+	template<class T>
+	void TypedColumnStatistics<T>::insert(const T& value){
+		if(number_of_rows_==0){
+			min_=value;
+			max_=value;
+		}else{
+			//a NaN does not bound the range, unless all values are NaN
+			if(value<min_ || is_unordered(min_,min_)) min_=value;
+			if(max_<value || is_unordered(max_,max_)) max_=value;
+			//values that cannot be ordered, e.g., a NaN, break both orders
+			const bool unordered = is_unordered(value,last_);
+			if(value<last_ || unordered) sorted_ascending_=false;
+			if(last_<value || unordered) sorted_descending_=false;
+		}
+		last_=value;
+		distinct_values_.add(compute_hash(value));
+		number_of_rows_++;
+		number_of_changes_++;
+	}
+
+	template<class T>
+	void TypedColumnStatistics<T>::update(const T& value, size_t number_of_rows, bool keeps_order){
+		if(number_of_rows==0) return;
+		if(value<min_ || is_unordered(min_,min_)) min_=value;
+		if(max_<value || is_unordered(max_,max_)) max_=value;
+		if(!keeps_order){
+			sorted_ascending_=false;
+			sorted_descending_=false;
+		}
+		distinct_values_.add(compute_hash(value));
+		number_of_changes_+=number_of_rows;
+	}
+
+	template<class T>
+	void TypedColumnStatistics<T>::remove(size_t number_of_rows){
+		//removing rows keeps the remaining rows sorted and their values between min_ and max_
+		number_of_rows_ -= std::min(number_of_rows,number_of_rows_);
+		number_of_changes_+=number_of_rows;
+	}
+
+	template<class T>
+	void TypedColumnStatistics<T>::clear(){
+		number_of_rows_=0;
+		sorted_ascending_=true;
+		sorted_descending_=true;
+		valid_=true;
+		number_of_changes_=0;
+		number_of_rows_at_rebuild_=0;
+		distinct_values_.clear();
+		min_=T();
+		max_=T();
+		last_=T();
+		histogram_.build(std::vector<T>());
+	}
+
+	template<class T>
+	void TypedColumnStatistics<T>::rebuild(const std::vector<T>& values){
+		clear();
+		for(size_t i=0;i<values.size();++i){
+			insert(values[i]);
+		}
+		std::vector<T> sorted_values(values);
+		if(!sorted_ascending_) std::sort(sorted_values.begin(),sorted_values.end());
+		histogram_.build(sorted_values);
+		number_of_changes_=0;
+		number_of_rows_at_rebuild_=values.size();
+	}
+
+	template<class T>
+	const boost::any TypedColumnStatistics<T>::getMinimum() const{
+		if(number_of_rows_==0) return boost::any();
+		return boost::any(min_);
+	}
+
+	template<class T>
+	const boost::any TypedColumnStatistics<T>::getMaximum() const{
+		if(number_of_rows_==0) return boost::any();
+		return boost::any(max_);
+	}
+
+	template<class T>
+	double TypedColumnStatistics<T>::estimateSelectivity(const boost::any& value_for_comparison, const ValueComparator comp) const{
+		ValuePredicate<T> predicate(value_for_comparison,comp);
+		if(!predicate.isValid()) return 1.0;
+		return estimateSelectivity(predicate);
+	}
+
+	template<class T>
+	double TypedColumnStatistics<T>::estimateSelectivity(const ValuePredicate<T>& predicate) const{
+		if(number_of_rows_==0) return 0.0;
+		if(!predicate.mayMatchRange(min_,max_)) return 0.0;
+		if(predicate.matchesRange(min_,max_)) return 1.0;
+		const double number_of_distinct_values = getNumberOfDistinctValues();
+		switch(predicate.getValueComparator()){
+			case LESSER: return histogram_.estimateLesser(predicate.getValue(),false);
+			case LESSER_EQUAL: return histogram_.estimateLesser(predicate.getValue(),true);
+			case GREATER: return 1.0-histogram_.estimateLesser(predicate.getValue(),true);
+			case GREATER_EQUAL: return 1.0-histogram_.estimateLesser(predicate.getValue(),false);
+			case EQUAL: return histogram_.estimateEqual(predicate.getValue(),number_of_distinct_values);
+			case NOT_EQUAL: return 1.0-histogram_.estimateEqual(predicate.getValue(),number_of_distinct_values);
+			case BETWEEN: return std::max(0.0,histogram_.estimateLesser(predicate.getUpperBound(),true)-histogram_.estimateLesser(predicate.getValue(),false));
+			case IN: {
+				double selectivity=0.0;
+				const std::vector<T>& values = predicate.getValues();
+				for(size_t i=0;i<values.size() && selectivity<1.0;++i){
+					selectivity+=histogram_.estimateEqual(values[i],number_of_distinct_values);
+				}
+				return std::min(selectivity,1.0);
+			}
+			//the filter does not tell how many keys it contains, so only its range is used
+			case BLOOM_FILTER: return 1.0;
+		}
+		return 1.0;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
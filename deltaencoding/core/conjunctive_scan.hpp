@@ -0,0 +1,50 @@
+#pragma once
+
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of rows a ConjunctiveScan processes per batch*/
+const size_t CONJUNCTIVE_SCAN_BATCH_SIZE = 4096;
+
+/*!
+ *  \brief     A ConjunctiveScan evaluates a conjunction of filter conditions on several columns of the same table in a single pass.
+ *  \details   The rows are processed in batches. The first filter condition produces a selection vector for a batch, each following
+ *             condition only checks the TIDs that survived so far. The first batch evaluates the conditions in the order of the selectivity
+ *             estimated from the ColumnStatistics. After each batch, the conditions are reordered by their observed
+ *             cost per row and selectivity, so cheap and selective conditions run first.
+ */
+class ConjunctiveScan{
+	public:
+	ConjunctiveScan();
+	/*! \brief adds the filter condition (value_for_comparison, comp) on column to the conjunction
+	 *  \return true for sucess and false in case the column does not have the same number of rows as the previous columns*/
+	bool addPredicate(ColumnPtr column, const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief evaluates the conjunction of all filter conditions
+	 * \return PositionListPtr to a PositionList, which represents the result*/
+	const PositionListPtr execute();
+	/*! \brief returns the current evaluation order as indices of the filter conditions in the order they were added*/
+	const std::vector<unsigned int>& getPredicateOrder() const throw();
+
+	private:
+	struct PredicateStatistics{
+		PredicateStatistics() : selectivity(1.0), cost_per_row(0.0), measured(false){}
+		/*! \brief fraction of rows passing the condition, estimated from the ColumnStatistics until the condition is measured*/
+		double selectivity;
+		/*! \brief seconds per evaluated row*/
+		double cost_per_row;
+		bool measured;
+	};
+	/*! \brief sorts the filter conditions by cost_per_row/(1-selectivity), which minimizes the expected cost of independent conditions*/
+	void reorderPredicates();
+	/*! \brief sorts the filter conditions by their estimated selectivity, used before the costs are known*/
+	void orderByEstimatedSelectivity();
+
+	std::vector<ColumnPtr> columns_;
+	std::vector<ColumnFilterPtr> filters_;
+	std::vector<PredicateStatistics> statistics_;
+	std::vector<unsigned int> order_;
+};
+
+}; //end namespace CogaDB
+
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <core/column.hpp>
+#include <core/column_algebra.hpp>
+#include <core/parallel.hpp>
+
+namespace CoGaDB{
+
+/*! \brief number of rows an Expression evaluates per batch, small enough that the intermediate results of a batch stay in the L1 cache*/
+const size_t EXPRESSION_BATCH_SIZE = 1024;
+
+/*!
+ *  \brief     An Expression is a tree of ColumnAlgebraOperations over columns and constants of type T, such as (a*b)+c/2.
+ *  \details   evaluate() compiles the tree into a list of instructions and runs all of them on one batch of rows before moving on
+ *             to the next batch, so every input column is read once, intermediate results never leave the cache and the input columns
+ *             are not modified. Each instruction processes a whole batch with vector instructions. The result is written into a new
+ *             column. If all input columns are materialized or dictionary compressed, the batches are evaluated by several threads.
+ */
+template<class T>
+class Expression{
+	public:
+	typedef shared_pointer_namespace::shared_ptr<Expression<T> > ExpressionPtr;
+
+	/*! \brief creates a leaf that reads the values of column, which has to have type T*/
+	static const ExpressionPtr column(ColumnPtr column);
+	/*! \brief creates a leaf with the same value in every row*/
+	static const ExpressionPtr constant(const T& value);
+	/*! \brief creates an inner node that computes left op right*/
+	static const ExpressionPtr operation(ColumnAlgebraOperation op, ExpressionPtr left, ExpressionPtr right);
+
+	/*! \brief evaluates the expression for all rows
+	 *  \return a new column with the results, or a NULL pointer in case the columns do not match, an integer is divided by zero or T is not numeric*/
+	const ColumnPtr evaluate(const std::string& result_name="expression") const;
+
+	private:
+	enum NodeType{COLUMN_NODE,CONSTANT_NODE,OPERATION_NODE};
+
+	Expression(NodeType node_type, ColumnPtr column, const T& value, ColumnAlgebraOperation op, ExpressionPtr left, ExpressionPtr right);
+
+	/*! \brief a single step of the compiled expression, which writes one batch of results into its own buffer*/
+	struct Instruction{
+		NodeType node_type;
+		/*! \brief input column of a COLUMN_NODE*/
+		ColumnBaseTyped<T>* column;
+		/*! \brief values of a materialized input column, NULL otherwise*/
+		const T* values;
+		/*! \brief codes and dictionary of a dictionary compressed input column, NULL otherwise*/
+		const std::vector<int>* codes;
+		const std::vector<T>* dictionary;
+		/*! \brief value of a CONSTANT_NODE*/
+		T value;
+		ColumnAlgebraOperation op;
+		/*! \brief indices of the instructions computing the operands of an OPERATION_NODE*/
+		size_t left;
+		size_t right;
+	};
+
+	/*! \brief appends the instructions of this subtree in post order and returns the index of the instruction computing its result*/
+	size_t compile(std::vector<Instruction>& program, std::vector<ColumnPtr>& columns) const;
+	/*! \brief returns a pointer to the values of a COLUMN_NODE for the rows [begin,end), which points into the input column for
+	 *  materialized columns and into buffer otherwise*/
+	static const T* getBatch(const Instruction& instruction, size_t begin, size_t end, T* buffer);
+
+	NodeType node_type_;
+	ColumnPtr column_;
+	T value_;
+	ColumnAlgebraOperation op_;
+	ExpressionPtr left_;
+	ExpressionPtr right_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	Expression<T>::Expression(NodeType node_type, ColumnPtr column, const T& value, ColumnAlgebraOperation op, ExpressionPtr left, ExpressionPtr right)
+		: node_type_(node_type), column_(column), value_(value), op_(op), left_(left), right_(right){
+
+	}
+
+	template<class T>
+	const typename Expression<T>::ExpressionPtr Expression<T>::column(ColumnPtr column){
+		return ExpressionPtr(new Expression<T>(COLUMN_NODE,column,T(),ADD,ExpressionPtr(),ExpressionPtr()));
+	}
+
+	template<class T>
+	const typename Expression<T>::ExpressionPtr Expression<T>::constant(const T& value){
+		return ExpressionPtr(new Expression<T>(CONSTANT_NODE,ColumnPtr(),value,ADD,ExpressionPtr(),ExpressionPtr()));
+	}
+
+	template<class T>
+	const typename Expression<T>::ExpressionPtr Expression<T>::operation(ColumnAlgebraOperation op, ExpressionPtr left, ExpressionPtr right){
+		return ExpressionPtr(new Expression<T>(OPERATION_NODE,ColumnPtr(),T(),op,left,right));
+	}
+
+	template<class T>
+	size_t Expression<T>::compile(std::vector<Instruction>& program, std::vector<ColumnPtr>& columns) const{
+		Instruction instruction = {node_type_,NULL,NULL,NULL,NULL,value_,op_,0,0};
+		if(node_type_==OPERATION_NODE){
+			if(!left_ || !right_) return size_t(-1);
+			instruction.left = left_->compile(program,columns);
+			if(instruction.left==size_t(-1)) return size_t(-1);
+			instruction.right = right_->compile(program,columns);
+			if(instruction.right==size_t(-1)) return size_t(-1);
+		}else if(node_type_==COLUMN_NODE){
+			if(!column_ || column_->type()!=typeid(T)){
+				std::cout << "Error! Expression: column " << (column_ ? column_->getName() : std::string("NULL")) << " has the wrong type" << std::endl;
+				return size_t(-1);
+			}
+			if(!columns.empty() && columns.front()->size()!=column_->size()){
+				std::cout << "Error! Expression: column " << column_->getName() << " has " << column_->size()
+				          << " rows, but column " << columns.front()->getName() << " has " << columns.front()->size() << " rows" << std::endl;
+				return size_t(-1);
+			}
+			columns.push_back(column_);
+			instruction.column = static_cast<ColumnBaseTyped<T>*>(column_.get());
+			Column<T>* materialized_column = dynamic_cast<Column<T>*>(instruction.column);
+			if(materialized_column) instruction.values = materialized_column->getContent().data();
+			instruction.codes = instruction.column->getDictionaryCodes();
+			instruction.dictionary = instruction.column->getDictionary();
+		}
+		program.push_back(instruction);
+		return program.size()-1;
+	}
+
+	template<class T>
+	const T* Expression<T>::getBatch(const Instruction& instruction, size_t begin, size_t end, T* buffer){
+		if(instruction.values) return instruction.values+begin;
+		if(instruction.codes && instruction.dictionary){
+			const int* codes = instruction.codes->data();
+			const T* dictionary = instruction.dictionary->data();
+			for(size_t i=begin;i<end;++i){
+				buffer[i-begin]=dictionary[codes[i]];
+			}
+		}else{
+			for(size_t i=begin;i<end;++i){
+				buffer[i-begin]=(*instruction.column)[i];
+			}
+		}
+		return buffer;
+	}
+
+	template<class T>
+	const ColumnPtr Expression<T>::evaluate(const std::string& result_name) const{
+		std::vector<Instruction> program;
+		std::vector<ColumnPtr> columns;
+		if(compile(program,columns)==size_t(-1)) return ColumnPtr();
+		if(columns.empty()){
+			std::cout << "Error! Expression: expression does not contain a column" << std::endl;
+			return ColumnPtr();
+		}
+		//constant operands are checked once, column operands per batch
+		bool thread_safe=true;
+		for(size_t i=0;i<program.size();++i){
+			const Instruction& instruction = program[i];
+			if(instruction.node_type==OPERATION_NODE && program[instruction.right].node_type==CONSTANT_NODE
+			   && !is_valid_operand(instruction.op,program[instruction.right].value)) return ColumnPtr();
+			//operator[] of compressed columns may not be called concurrently
+			if(instruction.node_type==COLUMN_NODE && !instruction.values && !(instruction.codes && instruction.dictionary)) thread_safe=false;
+		}
+
+		const size_t number_of_rows = columns.front()->size();
+		shared_pointer_namespace::shared_ptr<Column<T> > result(new Column<T>(result_name,columns.front()->getType()));
+		std::vector<T>& result_values = result->getContent();
+		result_values.resize(number_of_rows);
+		T* result_data = result_values.data();
+		const size_t number_of_instructions = program.size();
+		std::atomic<bool> failed(false);
+
+		parallel_for_chunks(number_of_rows,thread_safe ? getNumberOfThreads(number_of_rows) : 1,
+			[&program,&failed,result_data,number_of_instructions](unsigned int, size_t chunk_begin, size_t chunk_end){
+				//one buffer per instruction, the buffers of constants are filled once
+				std::vector<T> buffers(number_of_instructions*EXPRESSION_BATCH_SIZE);
+				std::vector<const T*> batches(number_of_instructions,static_cast<const T*>(NULL));
+				for(size_t i=0;i<number_of_instructions;++i){
+					if(program[i].node_type==CONSTANT_NODE){
+						std::fill(buffers.begin()+i*EXPRESSION_BATCH_SIZE,buffers.begin()+(i+1)*EXPRESSION_BATCH_SIZE,program[i].value);
+						batches[i]=&buffers[i*EXPRESSION_BATCH_SIZE];
+					}
+				}
+				for(size_t begin=chunk_begin;begin<chunk_end && !failed;begin+=EXPRESSION_BATCH_SIZE){
+					const size_t end = std::min(begin+EXPRESSION_BATCH_SIZE,chunk_end);
+					const size_t n = end-begin;
+					for(size_t i=0;i<number_of_instructions;++i){
+						const Instruction& instruction = program[i];
+						//the last instruction writes directly into the result column
+						T* target = (i+1==number_of_instructions) ? result_data+begin : &buffers[i*EXPRESSION_BATCH_SIZE];
+						if(instruction.node_type==COLUMN_NODE){
+							batches[i]=getBatch(instruction,begin,end,target);
+						}else if(instruction.node_type==OPERATION_NODE){
+							const Instruction& right = program[instruction.right];
+							bool success;
+							if(right.node_type==CONSTANT_NODE){
+								success=apply_constant_operation(target,batches[instruction.left],n,instruction.op,right.value);
+							}else{
+								success=is_valid_operand_array(instruction.op,batches[instruction.right],n)
+								        && apply_column_operation(target,batches[instruction.left],batches[instruction.right],n,instruction.op);
+							}
+							if(!success){
+								failed=true;
+								return;
+							}
+							batches[i]=target;
+						}
+					}
+					//expressions without operations copy their only leaf
+					if(batches[number_of_instructions-1]!=result_data+begin){
+						std::copy(batches[number_of_instructions-1],batches[number_of_instructions-1]+n,result_data+begin);
+					}
+				}
+			});
+		if(failed) return ColumnPtr();
+		return result;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+
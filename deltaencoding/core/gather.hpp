@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <core/base_column.hpp>
+#include <core/bitmap.hpp>
+#include <core/radix_sort.hpp>
+
+namespace CoGaDB{
+
+template<class T>
+class ColumnBaseTyped; //forward declaration
+
+/*! \brief number of positions a gather prefetches ahead, so the cache misses of random TIDs overlap*/
+const size_t GATHER_PREFETCH_DISTANCE = 16;
+
+/*! \brief returns true if all TIDs are smaller than number_of_rows*/
+inline bool is_valid_position_list(const PositionList& tids, size_t number_of_rows){
+	for(size_t i=0;i<tids.size();++i){
+		if(tids[i]>=number_of_rows) return false;
+	}
+	return true;
+}
+
+/*! \brief returns true if the TIDs are sorted ascending*/
+inline bool is_sorted_position_list(const PositionList& tids){
+	for(size_t i=1;i<tids.size();++i){
+		if(tids[i]<tids[i-1]) return false;
+	}
+	return true;
+}
+
+/*! \brief returns true if the TIDs form a range without gaps, i.e., tids[i]==tids[0]+i*/
+inline bool is_dense_position_list(const TID* tids, size_t number_of_tids){
+	for(size_t i=1;i<number_of_tids;++i){
+		if(tids[i]!=tids[0]+i) return false;
+	}
+	return true;
+}
+
+/*! \brief copies values[tids[i]] to result[i]
+ *  \details a dense range of TIDs is copied as a block, otherwise the values GATHER_PREFETCH_DISTANCE positions ahead are prefetched*/
+template<class T>
+void gather_values(T* result, const T* values, const TID* tids, size_t number_of_tids){
+	if(is_dense_position_list(tids,number_of_tids)){
+		if(number_of_tids>0) std::copy(values+tids[0],values+tids[0]+number_of_tids,result);
+		return;
+	}
+	size_t i=0;
+	for(;i+GATHER_PREFETCH_DISTANCE<number_of_tids;++i){
+		__builtin_prefetch(values+tids[i+GATHER_PREFETCH_DISTANCE]);
+		result[i]=values[tids[i]];
+	}
+	for(;i<number_of_tids;++i){
+		result[i]=values[tids[i]];
+	}
+}
+
+/*! \brief decodes dictionary[codes[tids[i]]] into result[i], prefetching the codes like gather_values
+ *  \details the dictionary is small compared to the codes, so only the accesses to the codes are prefetched*/
+template<class T>
+void gather_dictionary_values(T* result, const int* codes, const T* dictionary, const TID* tids, size_t number_of_tids){
+	size_t i=0;
+	for(;i+GATHER_PREFETCH_DISTANCE<number_of_tids;++i){
+		__builtin_prefetch(codes+tids[i+GATHER_PREFETCH_DISTANCE]);
+		result[i]=dictionary[codes[tids[i]]];
+	}
+	for(;i<number_of_tids;++i){
+		result[i]=dictionary[codes[tids[i]]];
+	}
+}
+
+/*! \brief returns the (TID,position in tids) pairs sorted by TID, so compressed columns can decode the requested rows in a single forward pass
+ *  and write each value to its position in the result*/
+inline std::vector<std::pair<TID,TID> > sort_positions(const PositionList& tids){
+	std::vector<std::pair<TID,TID> > positions(tids.size());
+	for(size_t i=0;i<tids.size();++i){
+		positions[i]=std::make_pair(tids[i],TID(i));
+	}
+	radix_sort_pairs(positions);
+	return positions;
+}
+
+/*! \brief decodes all values of a column, compressed columns are decoded with gather, because operator[] is slow and not thread safe for them*/
+template<class T>
+void decode_values(ColumnBaseTyped<T>& column, std::vector<T>& values){
+	values.clear();
+	if(column.size()==0) return;
+	ColumnPtr materialized_column;
+	ColumnBaseTyped<T>* decoded_column = &column;
+	if(!column.isMaterialized()){
+		materialized_column = column.gather(BitmapPtr(new Bitmap(column.size(),true)));
+		decoded_column = static_cast<ColumnBaseTyped<T>*>(materialized_column.get());
+	}
+	values.resize(decoded_column->size());
+	for(unsigned int i=0;i<values.size();i++){
+		values[i]=(*decoded_column)[i];
+	}
+}
+
+/*! \brief decodes the values of the rows whose bits are set in filter in ascending TID order, a NULL filter selects all rows*/
+template<class T>
+void decode_values(ColumnBaseTyped<T>& column, BitmapPtr filter, std::vector<T>& values){
+	if(!filter){
+		decode_values(column,values);
+		return;
+	}
+	values.clear();
+	if(filter->count()==0) return;
+	ColumnPtr selected_column = column.gather(filter);
+	decode_values(*static_cast<ColumnBaseTyped<T>*>(selected_column.get()),values);
+}
+
+}; //end namespace CogaDB
+
@@ -17,15 +17,19 @@ enum AttributeType{INT,FLOAT,VARCHAR,BOOLEAN};
 
 enum ComputeDevice{CPU,GPU};
 
-enum AggregationMethod{SUM,MIN,MAX};
+enum AggregationMethod{SUM,MIN,MAX,COUNT,AVG};
 
-enum ValueComparator{LESSER,GREATER,EQUAL};
+enum ValueComparator{LESSER,GREATER,EQUAL,LESSER_EQUAL,GREATER_EQUAL,NOT_EQUAL,BETWEEN,IN,BLOOM_FILTER};
 
 enum SortOrder{ASCENDING,DESCENDING};
 
 enum Operation{SELECTION,PROJECTION,JOIN,GROUPBY,SORT,COPY,AGGREGATION,FULL_SCAN,INDEX_SCAN};
 
-enum JoinAlgorithm{SORT_MERGE_JOIN,NESTED_LOOP_JOIN,HASH_JOIN};
+enum JoinAlgorithm{SORT_MERGE_JOIN,NESTED_LOOP_JOIN,HASH_JOIN,AUTO_JOIN};
+
+enum GroupByAlgorithm{SORT_BASED_GROUP_BY,HASH_BASED_GROUP_BY,AUTO_GROUP_BY};
+
+enum ColumnAlgebraOperation{ADD,SUB,MUL,DIV};
 
 enum MaterializationStatus{MATERIALIZE,LOOKUP};
 
@@ -53,6 +57,18 @@ typedef std::list<Attribut> TableSchema;
 
 typedef std::vector<boost::any> Tuple;
 
+/*! \brief returns true if neither value is smaller than the other, but they are not equal, i.e., one of them is a NaN
+ *  \details is_unordered(x,x) is true only if x is a NaN*/
+template<class T>
+inline bool is_unordered(const T& a, const T& b){
+	return !(a<b) && !(b<a) && !(a==b);
+}
+
+/*! \brief strings are totally ordered, so the comparisons can be skipped*/
+inline bool is_unordered(const std::string&, const std::string&){
+	return false;
+}
+
 //struct Attribut {
 
 //	AttributeType type_;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include <boost/functional/hash.hpp>
+
+namespace CoGaDB{
+
+/*! \brief returns a 64 bit hash of value, whose bits are all equally distributed
+ *  \details mixes the bits of boost::hash, which is the identity function for integers, with the finalizer of MurmurHash3, 
+ *  so the hash can be split into several independent parts, e.g., by BloomFilter and HyperLogLog*/
+template<class T>
+inline uint64_t compute_hash(const T& value){
+	uint64_t hash = boost::hash<T>()(value);
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+}; //end namespace CogaDB
+
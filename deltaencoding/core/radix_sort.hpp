@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <stdint.h>
+#include <core/base_column.hpp>
+#include <core/parallel.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     RadixKey maps a value of type T to an unsigned integer key, so that the unsigned order of the keys equals the order of the values.
+ *  \details   Types without a RadixKey specialization are sorted by comparison.
+ */
+template<typename T>
+struct RadixKey;
+
+template<>
+struct RadixKey<int>{
+	typedef uint32_t KeyType;
+	/*! \brief flips the sign bit, so that negative values are ordered before positive values*/
+	static inline KeyType encode(const int value){
+		return static_cast<uint32_t>(value) ^ 0x80000000u;
+	}
+};
+
+template<>
+struct RadixKey<float>{
+	typedef uint32_t KeyType;
+	/*! \brief flips all bits of negative values and the sign bit of positive values (IEEE 754 total order)*/
+	static inline KeyType encode(const float value){
+		//-0.0 and +0.0 compare equal, so they have to get the same key
+		float normalized = (value==0.0f) ? 0.0f : value;
+		uint32_t bits;
+		std::memcpy(&bits,&normalized,sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+};
+
+/*! \brief for strings, the key is a normalized prefix: the first 8 bytes in big endian order, padded with zero bytes
+ *  \details the key order is consistent with std::string::compare, but two strings with the same prefix are not necessarily equal,
+ *  so ties have to be resolved by comparing the full strings*/
+template<>
+struct RadixKey<std::string>{
+	typedef uint64_t KeyType;
+	static inline KeyType encode(const std::string& value){
+		KeyType key=0;
+		const size_t length = value.size();
+		for(size_t i=0;i<sizeof(KeyType);++i){
+			key <<= 8;
+			if(i<length) key |= static_cast<unsigned char>(value[i]);
+		}
+		return key;
+	}
+};
+
+/*! \brief sorts the n (key,TID) pairs in data by the lowest number_of_passes bytes of their keys using an LSD radix sort with 8 bit digits
+ *  \details the sort is stable, so pairs with equal keys keep their relative order. Passes in which all keys share the same digit are skipped.
+ *  buffer has to hold n pairs and is overwritten, the sorted pairs are stored in data.*/
+template<typename KeyType>
+void radix_sort_pairs(std::pair<KeyType,TID>* data, std::pair<KeyType,TID>* buffer, size_t n, unsigned int number_of_passes){
+	typedef std::pair<KeyType,TID> Pair;
+	if(n<2 || number_of_passes==0) return;
+
+	//build the histograms of all passes in a single scan
+	std::vector<size_t> histograms(number_of_passes*256,0);
+	for(size_t i=0;i<n;++i){
+		KeyType key = data[i].first;
+		for(unsigned int pass=0;pass<number_of_passes;++pass){
+			histograms[pass*256+((key >> (pass*8)) & 0xFF)]++;
+		}
+	}
+
+	//every pass permutes the pairs, so any pair tells whether all keys share a digit
+	const KeyType first_key = data[0].first;
+	Pair* source = data;
+	Pair* target = buffer;
+	for(unsigned int pass=0;pass<number_of_passes;++pass){
+		size_t* histogram = &histograms[pass*256];
+		//all keys have the same digit, so this pass would not change anything
+		if(histogram[(first_key >> (pass*8)) & 0xFF]==n) continue;
+
+		size_t offsets[256];
+		size_t sum=0;
+		for(unsigned int digit=0;digit<256;++digit){
+			offsets[digit]=sum;
+			sum+=histogram[digit];
+		}
+		for(size_t i=0;i<n;++i){
+			const Pair& p = source[i];
+			target[offsets[(p.first >> (pass*8)) & 0xFF]++]=p;
+		}
+		std::swap(source,target);
+	}
+	if(source!=data) std::copy(source,source+n,data);
+}
+
+/*! \brief sorts a vector of (key,TID) pairs by key using an LSD radix sort with 8 bit digits
+ *  \details the sort is stable, so pairs with equal keys keep their relative order. Passes in which all keys share the same digit are skipped.*/
+template<typename KeyType>
+void radix_sort_pairs(std::vector<std::pair<KeyType,TID> >& data){
+	typedef std::pair<KeyType,TID> Pair;
+	const size_t n = data.size();
+	if(n<2) return;
+	std::vector<Pair> buffer(n);
+	radix_sort_pairs(data.data(),buffer.data(),n,sizeof(KeyType));
+}
+
+/*! \brief sorts a vector of (key,TID) pairs by key with up to number_of_threads threads of the TaskScheduler
+ *  \details an MSD pass partitions the pairs by the most significant byte in which the keys differ, then the partitions are sorted
+ *  independently by the lower bytes with radix_sort_pairs. The partition pass scatters the morsels in order, so the sort is stable as well.
+ *  Small inputs are sorted by a single thread.*/
+template<typename KeyType>
+void parallel_radix_sort_pairs(std::vector<std::pair<KeyType,TID> >& data, unsigned int number_of_threads){
+	typedef std::pair<KeyType,TID> Pair;
+	const size_t n = data.size();
+	if(number_of_threads<=1 || n<=MORSEL_SIZE){
+		radix_sort_pairs(data);
+		return;
+	}
+
+	//the bytes above the partition digit are the same for all keys, so they do not have to be sorted
+	const KeyType first_key = data[0].first;
+	std::vector<KeyType> differences(number_of_threads,0);
+	parallel_for_chunks(n,number_of_threads,
+		[&data,&differences,first_key](unsigned int thread_id, size_t begin, size_t end){
+			KeyType difference=0;
+			for(size_t i=begin;i<end;++i){
+				difference |= data[i].first ^ first_key;
+			}
+			differences[thread_id] |= difference;
+		});
+	KeyType difference=0;
+	for(unsigned int i=0;i<number_of_threads;++i){
+		difference |= differences[i];
+	}
+	//all keys are equal, so the pairs are already sorted
+	if(difference==0) return;
+	unsigned int digit_position = sizeof(KeyType)-1;
+	while((difference >> (digit_position*8))==0) digit_position--;
+	const unsigned int shift = digit_position*8;
+
+	//one histogram per morsel, so the morsels can be scattered in parallel
+	const size_t number_of_morsels = (n+MORSEL_SIZE-1)/MORSEL_SIZE;
+	std::vector<size_t> offsets(number_of_morsels*256,0);
+	parallel_for_chunks(n,number_of_threads,
+		[&data,&offsets,shift](unsigned int, size_t begin, size_t end){
+			size_t* histogram = &offsets[(begin/MORSEL_SIZE)*256];
+			for(size_t i=begin;i<end;++i){
+				histogram[(data[i].first >> shift) & 0xFF]++;
+			}
+		});
+	//the pairs of a partition are ordered by morsel, which keeps the partition pass stable
+	std::vector<size_t> partitions(257);
+	size_t sum=0;
+	for(unsigned int digit=0;digit<256;++digit){
+		partitions[digit]=sum;
+		for(size_t morsel=0;morsel<number_of_morsels;++morsel){
+			const size_t count = offsets[morsel*256+digit];
+			offsets[morsel*256+digit]=sum;
+			sum+=count;
+		}
+	}
+	partitions[256]=n;
+
+	std::vector<Pair> buffer(n);
+	parallel_for_chunks(n,number_of_threads,
+		[&data,&buffer,&offsets,shift](unsigned int, size_t begin, size_t end){
+			size_t* morsel_offsets = &offsets[(begin/MORSEL_SIZE)*256];
+			for(size_t i=begin;i<end;++i){
+				buffer[morsel_offsets[(data[i].first >> shift) & 0xFF]++]=data[i];
+			}
+		});
+	//sorts the partitions in the buffer, data is the scratch space of the partitions
+	parallel_for_chunks(256,number_of_threads,
+		[&data,&buffer,&partitions,digit_position](unsigned int, size_t first_digit, size_t last_digit){
+			for(size_t digit=first_digit;digit<last_digit;++digit){
+				const size_t begin = partitions[digit];
+				radix_sort_pairs(buffer.data()+begin,data.data()+begin,partitions[digit+1]-begin,digit_position);
+			}
+		},1);
+	data.swap(buffer);
+}
+
+}; //end namespace CogaDB
+
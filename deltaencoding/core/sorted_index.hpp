@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <stdint.h>
+#include <core/base_column.hpp>
+#include <core/predicate.hpp>
+
+namespace CoGaDB{
+
+/*! \brief largest number of entries of a node of a SortedIndex, the keys of a node are stored in one array, so a search in a node touches few cache lines*/
+const size_t SORTED_INDEX_NODE_SIZE = 64;
+
+/*! \brief largest estimated selectivity of a predicate for which selection looks up the rows in a SortedIndex instead of scanning the column,
+ *  because the TIDs of an index lookup have to be sorted and reading them from the leaves is slower than a sequential scan*/
+const double INDEX_SCAN_MAX_SELECTIVITY = 0.05;
+
+/*!
+ *  \brief     A SortedIndex is a B+-tree on the (value,TID) pairs of a column, which answers point and range lookups with a PositionList.
+ *  \details   Each node stores its keys, the TIDs of its keys and its children in separate arrays, so the binary search in a node only reads keys.
+ *             The entries are ordered by value and by TID among equal values, so every entry is unique and can be removed without scanning
+ *             the duplicates of its value. The leaves are chained for range scans. Nodes are allocated from one array and referenced by their
+ *             position in this array. Removed entries leave underfull nodes behind, which are not merged, because the index is rebuilt
+ *             in bulk after modifications that affect many rows.
+ */
+template<class T>
+class SortedIndex{
+	public:
+	SortedIndex();
+
+	/*! \brief builds the index bottom up from the values of a column and their TIDs in ascending order of the values, e.g., the result of sort(ASCENDING)*/
+	void build(const std::vector<T>& values, const PositionList& sorted_tids);
+	/*! \brief inserts the entry (value,tid)*/
+	void insert(const T& value, TID tid);
+	/*! \brief removes the entry (value,tid)
+	 *  \return false if the index contains no such entry*/
+	bool remove(const T& value, TID tid);
+	/*! \brief decrements all TIDs larger than tid, after row tid was removed from the column and its entry from the index*/
+	void shiftTIDs(TID tid);
+	void clear();
+	/*! \brief marks the index as outdated, e.g., after many rows were modified, so the column rebuilds it before the next lookup*/
+	void invalidate() throw(){ valid_=false; }
+	bool isValid() const throw(){ return valid_; }
+	size_t size() const throw(){ return number_of_entries_; }
+
+	/*! \brief returns the TIDs of the entries matching the predicate in ascending order
+	 *  \return a NULL pointer if the ValueComparator does not select ranges of values (NOT_EQUAL, BLOOM_FILTER)*/
+	const PositionListPtr lookup(const ValuePredicate<T>& predicate) const;
+
+	private:
+	static const uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+	struct Node{
+		Node() : keys(), tids(), children(), next(NO_NODE){}
+		/*! \brief the values of the entries of a leaf, or the smallest value in children[i+1] for an inner node*/
+		std::vector<T> keys;
+		std::vector<TID> tids;
+		std::vector<uint32_t> children;
+		/*! \brief next leaf in ascending order*/
+		uint32_t next;
+	};
+	/*! \brief strict weak ordering on the entries (value,tid)*/
+	static inline bool isLesser(const T& value, TID tid, const T& other_value, TID other_tid){
+		return value<other_value || (!(other_value<value) && tid<other_tid);
+	}
+	/*! \brief returns the position of the first key of node, which is not before (value,tid)*/
+	size_t lowerBound(const Node& node, const T& value, TID tid) const;
+	/*! \brief returns the position of the first key of node, which is after (value,tid)*/
+	size_t upperBound(const Node& node, const T& value, TID tid) const;
+	/*! \brief inserts the entry into the subtree of node at level, which is 0 for leaves
+	 *  \return true if the node was split, in this case new_node is the right half and (separator_value,separator_tid) its smallest entry*/
+	bool insertInto(uint32_t node, unsigned int level, const T& value, TID tid, T& separator_value, TID& separator_tid, uint32_t& new_node);
+	/*! \brief appends the TIDs of the entries from the first entry for which is_before is false to the first entry for which is_after is true
+	 *  \details is_before has to be true for a prefix and is_after for a suffix of the entries*/
+	template<typename IsBefore, typename IsAfter>
+	void scan(IsBefore is_before, IsAfter is_after, PositionList& result) const;
+
+	std::vector<Node> nodes_;
+	uint32_t root_;
+	/*! \brief number of inner levels, the root is a leaf if the height is 0*/
+	unsigned int height_;
+	size_t number_of_entries_;
+	bool valid_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	const uint32_t SortedIndex<T>::NO_NODE;
+
+	template<class T>
+	SortedIndex<T>::SortedIndex() : nodes_(1), root_(0), height_(0), number_of_entries_(0), valid_(true){
+
+	}
+
+	template<class T>
+	void SortedIndex<T>::clear(){
+		nodes_.assign(1,Node());
+		root_=0;
+		height_=0;
+		number_of_entries_=0;
+		valid_=true;
+	}
+
+	template<class T>
+	void SortedIndex<T>::build(const std::vector<T>& values, const PositionList& sorted_tids){
+		clear();
+		std::vector<std::pair<T,TID> > entries(sorted_tids.size());
+		for(size_t i=0;i<sorted_tids.size();i++){
+			entries[i] = std::pair<T,TID>(values[sorted_tids[i]],sorted_tids[i]);
+		}
+		//an unstable sort may leave equal values out of TID order
+		for(size_t i=1;i<entries.size();i++){
+			if(isLesser(entries[i].first,entries[i].second,entries[i-1].first,entries[i-1].second)){
+				std::sort(entries.begin(),entries.end());
+				break;
+			}
+		}
+		if(entries.empty()) return;
+
+		//fill the leaves completely, level holds the nodes of the current level and the smallest entry of their subtree
+		nodes_.clear();
+		std::vector<uint32_t> level;
+		for(size_t begin=0;begin<entries.size();begin+=SORTED_INDEX_NODE_SIZE){
+			const size_t end = std::min(begin+SORTED_INDEX_NODE_SIZE,entries.size());
+			if(!nodes_.empty()) nodes_.back().next = uint32_t(nodes_.size());
+			nodes_.push_back(Node());
+			Node& leaf = nodes_.back();
+			leaf.keys.reserve(end-begin);
+			leaf.tids.reserve(end-begin);
+			for(size_t i=begin;i<end;i++){
+				leaf.keys.push_back(entries[i].first);
+				leaf.tids.push_back(entries[i].second);
+			}
+			level.push_back(uint32_t(nodes_.size()-1));
+		}
+		std::vector<std::pair<T,TID> > smallest_entries;
+		for(size_t i=0;i<level.size();i++){
+			smallest_entries.push_back(entries[i*SORTED_INDEX_NODE_SIZE]);
+		}
+		//build the inner levels, each inner node has up to SORTED_INDEX_NODE_SIZE+1 children
+		height_=0;
+		while(level.size()>1){
+			std::vector<uint32_t> parents;
+			std::vector<std::pair<T,TID> > parent_smallest_entries;
+			for(size_t begin=0;begin<level.size();begin+=SORTED_INDEX_NODE_SIZE+1){
+				const size_t end = std::min(begin+SORTED_INDEX_NODE_SIZE+1,level.size());
+				Node node;
+				for(size_t i=begin;i<end;i++){
+					if(i>begin){
+						node.keys.push_back(smallest_entries[i].first);
+						node.tids.push_back(smallest_entries[i].second);
+					}
+					node.children.push_back(level[i]);
+				}
+				nodes_.push_back(node);
+				parents.push_back(uint32_t(nodes_.size()-1));
+				parent_smallest_entries.push_back(smallest_entries[begin]);
+			}
+			level.swap(parents);
+			smallest_entries.swap(parent_smallest_entries);
+			height_++;
+		}
+		root_=level.front();
+		number_of_entries_=entries.size();
+	}
+
+	template<class T>
+	size_t SortedIndex<T>::lowerBound(const Node& node, const T& value, TID tid) const{
+		size_t begin=0;
+		size_t end=node.keys.size();
+		while(begin<end){
+			size_t middle = begin+(end-begin)/2;
+			if(isLesser(node.keys[middle],node.tids[middle],value,tid)){
+				begin=middle+1;
+			}else{
+				end=middle;
+			}
+		}
+		return begin;
+	}
+
+	template<class T>
+	size_t SortedIndex<T>::upperBound(const Node& node, const T& value, TID tid) const{
+		size_t begin=0;
+		size_t end=node.keys.size();
+		while(begin<end){
+			size_t middle = begin+(end-begin)/2;
+			if(!isLesser(value,tid,node.keys[middle],node.tids[middle])){
+				begin=middle+1;
+			}else{
+				end=middle;
+			}
+		}
+		return begin;
+	}
+
+	template<class T>
+	void SortedIndex<T>::insert(const T& value, TID tid){
+		T separator_value = T();
+		TID separator_tid = 0;
+		uint32_t new_node = NO_NODE;
+		if(insertInto(root_,height_,value,tid,separator_value,separator_tid,new_node)){
+			//the root was split, so the tree grows by one level
+			Node root;
+			root.keys.push_back(separator_value);
+			root.tids.push_back(separator_tid);
+			root.children.push_back(root_);
+			root.children.push_back(new_node);
+			nodes_.push_back(root);
+			root_=uint32_t(nodes_.size()-1);
+			height_++;
+		}
+		number_of_entries_++;
+	}
+
+	template<class T>
+	bool SortedIndex<T>::insertInto(uint32_t node, unsigned int level, const T& value, TID tid, T& separator_value, TID& separator_tid, uint32_t& new_node){
+		if(level==0){
+			const size_t position = lowerBound(nodes_[node],value,tid);
+			nodes_[node].keys.insert(nodes_[node].keys.begin()+position,value);
+			nodes_[node].tids.insert(nodes_[node].tids.begin()+position,tid);
+			if(nodes_[node].keys.size()<=SORTED_INDEX_NODE_SIZE) return false;
+			//split the leaf in halves and link the right half behind it
+			Node right;
+			const size_t half = nodes_[node].keys.size()/2;
+			right.keys.assign(nodes_[node].keys.begin()+half,nodes_[node].keys.end());
+			right.tids.assign(nodes_[node].tids.begin()+half,nodes_[node].tids.end());
+			right.next = nodes_[node].next;
+			nodes_[node].keys.resize(half);
+			nodes_[node].tids.resize(half);
+			separator_value = right.keys.front();
+			separator_tid = right.tids.front();
+			nodes_.push_back(right);
+			new_node = uint32_t(nodes_.size()-1);
+			nodes_[node].next = new_node;
+			return true;
+		}
+
+		//children[i] holds the entries between keys[i-1] and keys[i]
+		const size_t position = upperBound(nodes_[node],value,tid);
+		T child_separator_value = T();
+		TID child_separator_tid = 0;
+		uint32_t new_child = NO_NODE;
+		if(!insertInto(nodes_[node].children[position],level-1,value,tid,child_separator_value,child_separator_tid,new_child)) return false;
+		//nodes_ may have grown, so the node is accessed by its position only after the recursion
+		nodes_[node].keys.insert(nodes_[node].keys.begin()+position,child_separator_value);
+		nodes_[node].tids.insert(nodes_[node].tids.begin()+position,child_separator_tid);
+		nodes_[node].children.insert(nodes_[node].children.begin()+position+1,new_child);
+		if(nodes_[node].keys.size()<=SORTED_INDEX_NODE_SIZE) return false;
+		//split the inner node, the middle key moves up to the parent
+		Node right;
+		const size_t half = nodes_[node].keys.size()/2;
+		separator_value = nodes_[node].keys[half];
+		separator_tid = nodes_[node].tids[half];
+		right.keys.assign(nodes_[node].keys.begin()+half+1,nodes_[node].keys.end());
+		right.tids.assign(nodes_[node].tids.begin()+half+1,nodes_[node].tids.end());
+		right.children.assign(nodes_[node].children.begin()+half+1,nodes_[node].children.end());
+		nodes_[node].keys.resize(half);
+		nodes_[node].tids.resize(half);
+		nodes_[node].children.resize(half+1);
+		nodes_.push_back(right);
+		new_node = uint32_t(nodes_.size()-1);
+		return true;
+	}
+
+	template<class T>
+	bool SortedIndex<T>::remove(const T& value, TID tid){
+		uint32_t node = root_;
+		for(unsigned int level=height_;level>0;level--){
+			node = nodes_[node].children[upperBound(nodes_[node],value,tid)];
+		}
+		Node& leaf = nodes_[node];
+		const size_t position = lowerBound(leaf,value,tid);
+		if(position==leaf.keys.size() || leaf.tids[position]!=tid || value<leaf.keys[position] || leaf.keys[position]<value) return false;
+		leaf.keys.erase(leaf.keys.begin()+position);
+		leaf.tids.erase(leaf.tids.begin()+position);
+		number_of_entries_--;
+		return true;
+	}
+
+	template<class T>
+	void SortedIndex<T>::shiftTIDs(TID tid){
+		//decrementing all larger TIDs keeps the order of the entries, so the separators stay valid
+		for(size_t i=0;i<nodes_.size();i++){
+			std::vector<TID>& tids = nodes_[i].tids;
+			for(size_t j=0;j<tids.size();j++){
+				if(tids[j]>tid) tids[j]--;
+			}
+		}
+	}
+
+	template<class T>
+	template<typename IsBefore, typename IsAfter>
+	void SortedIndex<T>::scan(IsBefore is_before, IsAfter is_after, PositionList& result) const{
+		//descend to the leftmost leaf that may contain an entry which is not before
+		uint32_t node = root_;
+		for(unsigned int level=height_;level>0;level--){
+			const Node& inner = nodes_[node];
+			size_t position = std::partition_point(inner.keys.begin(),inner.keys.end(),is_before)-inner.keys.begin();
+			node = inner.children[position];
+		}
+		for(;node!=NO_NODE;node=nodes_[node].next){
+			const Node& leaf = nodes_[node];
+			for(size_t i=std::partition_point(leaf.keys.begin(),leaf.keys.end(),is_before)-leaf.keys.begin();i<leaf.keys.size();i++){
+				if(is_after(leaf.keys[i])) return;
+				result.push_back(leaf.tids[i]);
+			}
+		}
+	}
+
+	template<class T>
+	const PositionListPtr SortedIndex<T>::lookup(const ValuePredicate<T>& predicate) const{
+		const T& value = predicate.getValue();
+		const T& upper = predicate.getUpperBound();
+		PositionListPtr result_tids( new PositionList());
+		PositionList& result = *result_tids;
+		switch(predicate.getValueComparator()){
+			case EQUAL:
+				scan([&value](const T& x){ return x<value; },[&value](const T& x){ return value<x; },result);
+				break;
+			case LESSER:
+				scan([](const T&){ return false; },[&value](const T& x){ return !(x<value); },result);
+				break;
+			case LESSER_EQUAL:
+				scan([](const T&){ return false; },[&value](const T& x){ return value<x; },result);
+				break;
+			case GREATER:
+				scan([&value](const T& x){ return !(value<x); },[](const T&){ return false; },result);
+				break;
+			case GREATER_EQUAL:
+				scan([&value](const T& x){ return x<value; },[](const T&){ return false; },result);
+				break;
+			case BETWEEN:
+				scan([&value](const T& x){ return x<value; },[&upper](const T& x){ return upper<x; },result);
+				break;
+			case IN:
+				for(size_t i=0;i<predicate.getValues().size();i++){
+					const T& element = predicate.getValues()[i];
+					scan([&element](const T& x){ return x<element; },[&element](const T& x){ return element<x; },result);
+				}
+				break;
+			case NOT_EQUAL:
+			case BLOOM_FILTER:
+				return PositionListPtr();
+		}
+		std::sort(result.begin(),result.end());
+		return result_tids;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
+